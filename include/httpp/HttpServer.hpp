@@ -13,7 +13,9 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <boost/asio.hpp>
@@ -21,6 +23,8 @@
 #include <commonpp/core/LoggingInterface.hpp>
 #include <commonpp/thread/ThreadPool.hpp>
 
+#include "httpp/http/helper/Compression.hpp"
+
 namespace HTTPP
 {
 namespace HTTP
@@ -54,6 +58,8 @@ public:
 private:
     struct Acceptor;
     using AcceptorPtr = std::shared_ptr<Acceptor>;
+    struct ConnectionRegistry;
+    struct ConnectionPool;
 
 public:
     using ConnectionPtr = HTTP::Connection*;
@@ -61,8 +67,16 @@ public:
     using ThreadPool = commonpp::thread::ThreadPool;
     using ThreadInit = ThreadPool::ThreadInit;
 
+    // Tag selecting the sharded mode: each thread owns its own io_context
+    // and its own SO_REUSEPORT listener on every bound address, so a
+    // connection stays on the thread that accepted it for its whole life.
+    struct Sharded
+    {
+    };
+
 public:
     HttpServer(size_t threads = 1);
+    HttpServer(size_t threads, Sharded);
     HttpServer(ThreadPool& pool);
     ~HttpServer();
 
@@ -74,16 +88,47 @@ public:
         const std::string& port = "443"
     );
 
+    // Where the listeners are bound, one per shard in sharded mode. With
+    // port "0" they all share the port picked by the system.
+    std::vector<boost::asio::ip::tcp::endpoint> getListeningEndpoints() const;
+
     void setSink(SinkCb cb)
     {
         sink_ = cb;
     }
 
+    // Number of async_accept kept in flight on every listener, applies to
+    // the listeners bound afterward.
+    void setAcceptDepth(size_t depth);
+
+    // Released connections are kept for reuse, up to max_pooled per thread
+    // (0 disables the pool). Their buffers are kept as long as they did not
+    // grow above max_buffer_size bytes.
+    void setConnectionPool(size_t max_pooled, size_t max_buffer_size);
+
+    // Every response gets a Date header, and a Server header with this value
+    // when it is not empty. To be set before start().
+    void setServerName(std::string_view name);
+
+    // Compress the responses with gzip or deflate when the request accepts
+    // it. A handler can still opt a response out, see Response.
+    void setCompression(HTTP::helper::CompressionOptions options = {})
+    {
+        compression_ = options;
+    }
+
+    // Every connection, including those created for an accept in flight.
     int getNbConnection() const noexcept
     {
         return connection_count_;
     }
 
+    // The accepted connections, not those waiting in an accept.
+    int getNbAcceptedConnection() const noexcept
+    {
+        return connection_count_ - pending_accepts_;
+    }
+
     void start(ThreadInit fct = ThreadInit());
     void stop();
 
@@ -95,8 +140,18 @@ private:
         const boost::system::error_code& error, AcceptorPtr acceptor, ConnectionPtr connection
     );
 
-    static AcceptorPtr
-    bind(boost::asio::io_service&, const std::string& address, const std::string& port);
+    void bind(
+        const std::string& address,
+        const std::string& port,
+        std::shared_ptr<boost::asio::ssl::context> ssl_ctx
+    );
+
+    static AcceptorPtr bind(
+        ThreadPool& pool,
+        const std::string& address,
+        const std::string& port,
+        bool reuse_port
+    );
 
 private: // called by Connection
     friend class ::HTTPP::HTTP::Connection;
@@ -104,6 +159,9 @@ private: // called by Connection
     void mark(ConnectionPtr connection);
     void destroy(ConnectionPtr connection, bool release = true);
 
+    ConnectionPtr acquire_connection(Acceptor& acceptor);
+    void release_connection(ConnectionPtr connection);
+
     void connection_error(ConnectionPtr connection, const boost::system::error_code& err);
 
     void connection_notify_request(ConnectionPtr connection);
@@ -111,15 +169,24 @@ private: // called by Connection
 
 private:
     bool running_ = false;
-    std::shared_ptr<ThreadPool> pool_;
+    bool sharded_ = false;
+    size_t accept_depth_ = 1;
+    // One pool in the default mode, one single threaded pool per shard in
+    // the sharded mode.
+    std::vector<std::shared_ptr<ThreadPool>> pools_;
     std::atomic_int running_acceptors_ = {0};
     std::atomic_int connection_count_ = {0};
+    // Connections created for an accept that has not completed yet
+    std::atomic_int pending_accepts_ = {0};
     std::vector<AcceptorPtr> acceptors_;
     SinkCb sink_;
     EventHandler* ev_hndl_ = nullptr;
+    // Preformatted "Server: <name>\r\n", empty when there is none.
+    std::string server_header_;
+    std::optional<HTTP::helper::CompressionOptions> compression_;
 
-    std::mutex connections_mutex_;
-    std::vector<ConnectionPtr> connections_;
+    std::unique_ptr<ConnectionRegistry> connections_;
+    std::unique_ptr<ConnectionPool> connection_pool_;
 };
 
 } // namespace HTTPP
@@ -21,9 +21,12 @@
 #include <commonpp/core/LoggingInterface.hpp>
 #include <commonpp/thread/ThreadPool.hpp>
 
+#include "Parser.hpp"
 #include "Request.hpp"
 #include "Response.hpp"
+#include "helper/ChunkedDecoder.hpp"
 #include "helper/ReadWholeRequest.hpp"
+#include "httpp/utils/ShardedIntrusiveList.hpp"
 
 namespace HTTPP
 {
@@ -49,6 +52,9 @@ class Connection
 
 public:
     static constexpr size_t BUF_SIZE = BUFSIZ;
+    // Responses to pipelined requests are held back until this much is
+    // queued, or there is no complete request left to handle.
+    static constexpr size_t PIPELINE_FLUSH_SIZE = 64 * 1024;
     using Callback = std::function<void()>;
 
     Connection(
@@ -170,8 +176,7 @@ public:
         auto capacity = request_buffer_.capacity() - offset_body_start_;
         if (capacity < buf_size)
         {
-            request_buffer_.reserve(offset_body_start_ + buf_size + 1);
-            reparse();
+            grow_request_buffer(offset_body_start_ + buf_size + 1);
         }
 
         request_buffer_.resize(request_buffer_.capacity(), 0);
@@ -197,6 +202,86 @@ public:
         );
     }
 
+    // Read a chunked transfer-encoded body, callable is given the decoded
+    // payload as it arrives, pointing in the connection buffer, then
+    // nullptr once the last chunk is read.
+    template <typename Callable, size_t BUFFER_SIZE = BUF_SIZE>
+    void read_chunked(Callable callable)
+    {
+        if (!own())
+        {
+            throw std::logic_error("Invalid connection state");
+        }
+
+        const char* data = request_buffer_.data() + offset_body_start_;
+        const char* end = request_buffer_.data() + request_buffer_.size();
+        std::string_view chunk;
+        for (;;)
+        {
+            auto status = chunked_decoder_.decode(data, end, chunk);
+            if (status == helper::ChunkedDecoder::Status::Data)
+            {
+                callable(boost::system::error_code(), chunk.data(), chunk.size());
+                continue;
+            }
+
+            if (status == helper::ChunkedDecoder::Status::Done)
+            {
+                // Keep what follows, it belongs to the next request.
+                offset_body_end_ = data - request_buffer_.data();
+                chunked_decoder_.reset();
+                disown();
+                callable(boost::system::error_code(), nullptr, 0);
+                return;
+            }
+
+            if (status == helper::ChunkedDecoder::Status::Error)
+            {
+                LOG(connection_detail::conn_logger_, error) << "Invalid chunked body received";
+                chunked_decoder_.reset();
+                disown();
+                callable(
+                    boost::system::errc::make_error_code(boost::system::errc::protocol_error),
+                    nullptr,
+                    0
+                );
+                return;
+            }
+
+            break;
+        }
+
+        // Everything buffered has been decoded, the next read reuses the
+        // same space.
+        request_buffer_.resize(offset_body_start_);
+        offset_body_end_ = offset_body_start_;
+        if (request_buffer_.capacity() - offset_body_start_ < BUFFER_SIZE)
+        {
+            grow_request_buffer(offset_body_start_ + BUFFER_SIZE);
+        }
+
+        request_buffer_.resize(request_buffer_.capacity(), 0);
+        async_read_some(
+            boost::asio::buffer(request_buffer_.data() + offset_body_start_, BUFFER_SIZE),
+            [callable = std::move(callable), this](const boost::system::error_code& ec, size_t size) mutable
+            {
+                disown();
+
+                if (ec)
+                {
+                    LOG(connection_detail::conn_logger_, error)
+                        << "Error detected while reading the body";
+                    chunked_decoder_.reset();
+                    callable(ec, nullptr, 0);
+                    return;
+                }
+
+                request_buffer_.resize(offset_body_start_ + size);
+                read_chunked<Callable, BUFFER_SIZE>(std::move(callable));
+            }
+        );
+    }
+
     template <typename Callable>
     void read_whole(size_t body_size, Callable callable)
     {
@@ -229,10 +314,7 @@ public:
         auto capacity = offset_body_end_ + 1;
         if (request_buffer_.capacity() < capacity)
         {
-            request_buffer_.reserve(capacity);
-            // pointer might have changed, so we need to reconstruct header,
-            // path, etc.
-            reparse();
+            grow_request_buffer(capacity);
         }
 
         request_buffer_.resize(capacity, 0);
@@ -257,15 +339,41 @@ public:
         );
     }
 
+    // A response that the request already has, according to the validators
+    // set on it, is sent as NotModified.
     void sendResponse();
+    // Send NotModified and return true if the request already has the
+    // response, before its body is built: set the validators, call this,
+    // and only build the body if it returned false.
+    bool sendIfNotModified();
     void sendContinue(Callback&& cb);
     std::pair<char*, size_t> mutable_body();
 
 private:
-    void reparse();
+    enum class Held : uint8_t
+    {
+        None,
+        // The handler runs with responses held
+        Dispatching,
+        // It returned without answering, they are being written
+        Flushing,
+        // What it did meanwhile
+        Send,
+        Release,
+    };
+
+    // Reallocate request_buffer_, the request is updated to point to the
+    // new storage.
+    void grow_request_buffer(size_t capacity);
 
 private:
-    static void release(Connection* connection);
+    // Prepare a released connection to be accepted again, the buffers are
+    // kept unless they have grown above max_buffer_size.
+    void reuse(boost::asio::ssl::context* ctx, size_t max_buffer_size);
+    boost::asio::io_context& service() noexcept
+    {
+        return socket_.get_executor().context();
+    }
 
     void start();
 
@@ -278,8 +386,31 @@ private:
     void close() noexcept;
 
     void read_request();
+    void reject_request();
     void recycle();
 
+    // Whether the bytes following the current request already hold a whole
+    // request header.
+    bool has_pipelined_request() const noexcept;
+
+    // Hand the parsed request to the handler. The responses held in
+    // output_buffer_ are written as soon as it returns without having
+    // answered, a response or a release made meanwhile waits for them.
+    void dispatch_request();
+    // The held responses as they are written, in output_buffers_.
+    const std::vector<boost::asio::const_buffer>& held_buffers();
+    void clear_held() noexcept;
+    void flush_held();
+    // Record what the handler did while the held responses are not yet
+    // written, false if they are.
+    bool defer_until_flushed(Held action) noexcept;
+    void resume(Held action);
+    void send_response();
+
+    // Whether the preconditions of a GET or HEAD request say that it
+    // already has the response being sent.
+    bool is_not_modified() const noexcept;
+
     template <typename... Args>
     void async_read_some(Args&&... a)
     {
@@ -312,6 +443,9 @@ private:
 
 private:
     HTTPP::HttpServer& handler_;
+    // Link in the HttpServer connection registry
+    UTILS::ShardedListHook registry_hook_;
+    size_t registry_shard_ = 0;
     // On construction, the HttpServer is the owner
     std::atomic_bool is_owned_ = {false};
     bool should_be_deleted_ = {false};
@@ -319,6 +453,21 @@ private:
     size_t size_ = 0;
     size_t offset_body_start_ = 0;
     size_t offset_body_end_ = 0;
+    helper::ChunkedDecoder chunked_decoder_;
+    // Serialized responses to pipelined requests, written along with the
+    // next response that is not held back. The segments of their bodies
+    // are shared, not copied: output_segments_ places them in between.
+    std::vector<char> output_buffer_;
+    std::vector<Response::QueuedSegment> output_segments_;
+    std::vector<boost::asio::const_buffer> output_buffers_;
+    std::atomic<Held> held_ = {Held::None};
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    // Where the current request starts in request_buffer_, the requests
+    // before it have been handled and their bytes are free to be reused.
+    size_t request_start_ = 0;
+    // Where the parsing of request_buffer_ stopped after the last read
+    Parser::State parser_state_;
+#endif
 
     std::mutex mutex_;
 
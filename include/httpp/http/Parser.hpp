@@ -31,7 +31,32 @@ public:
     Parser() = delete;
     static bool isComplete(const char* buffer, size_t n);
 
+    // Look for the "\r\n\r\n" ending the header block, starting at offset
+    // from. Return the offset following it, or 0 if it is not there yet.
+    static size_t findHeaderEnd(const char* buffer, size_t n, size_t from = 0);
+
 #if HTTPP_PARSER_BACKEND_IS_RAGEL
+    enum class Result
+    {
+        Incomplete,
+        Complete,
+        Error,
+    };
+
+    // Progress of a request being parsed across several reads. Positions
+    // are offsets in the buffer so that it can grow between two calls.
+    struct State
+    {
+        static constexpr size_t NO_TOKEN = size_t(-1);
+
+        int cs = -1;
+        size_t offset = 0;
+        size_t token_begin = NO_TOKEN;
+    };
+
+    // Resume parsing buffer[state.offset, n), buffer must still hold the
+    // bytes given to the previous calls.
+    static Result parse(State& state, const char* buffer, size_t n, Request& request);
     static bool parse(const char* start, const char* end, size_t& consumed, Request& request);
 #else
     static bool parse(std::istream& is, Request& request);
@@ -11,6 +11,8 @@
 #ifndef HTTPP_HTTP_PROTOCOL_HPP_
 #define HTTPP_HTTP_PROTOCOL_HPP_
 
+#include <cstdint>
+#include <ctime>
 #include <string>
 #include <string_view>
 
@@ -28,7 +30,7 @@ using KV = std::pair<std::string, std::string>;
 using KVRef = std::pair<std::string_view, std::string_view>;
 using Header = KV;
 #if HTTPP_PARSER_BACKEND_IS_RAGEL
-using QueryParamRef = std::pair<std::string, UTILS::LazyDecodedValue>;
+using QueryParamRef = std::pair<UTILS::LazyDecodedValue, UTILS::LazyDecodedValue>;
 using HeaderRef = KVRef;
 #else
 using QueryParamRef = KV;
@@ -46,9 +48,14 @@ enum class Method
     DELETE_, // '_' for msvc workaround
     OPTIONS,
     TRACE,
-    CONNECT
+    CONNECT,
+    PATCH,
+    // Any other method token, the name is in Request::method_name
+    EXTENSION,
 };
 
+static constexpr size_t NB_METHODS = size_t(Method::EXTENSION) + 1;
+
 std::string_view to_string(Method method);
 Method method_from(std::string_view str);
 
@@ -107,6 +114,103 @@ enum class HttpCode : unsigned int
 };
 
 std::string_view getDefaultMessage(HttpCode code);
+// "HTTP/1.1 <code> <message>\r\n", empty for a value not in HttpCode.
+std::string_view status_line(HttpCode code);
+
+// IMF-fixdate of RFC 7231, "Sun, 06 Nov 1994 08:49:37 GMT".
+static constexpr size_t HTTP_DATE_SIZE = 29;
+void format_http_date(std::time_t time, char (&out)[HTTP_DATE_SIZE]) noexcept;
+// Parse an IMF-fixdate, false if str is not one. The obsolete formats are
+// not accepted, clients send back the date they were given.
+bool parse_http_date(std::string_view str, std::time_t& time) noexcept;
+// "Date: <now>\r\n", formatted again by a thread at most once a second.
+std::string_view date_header();
+
+// Standard header names, recognized by the parser with a perfect hash.
+#define HTTPP_APPLY_ON_HEADER(FN)                                              \
+    FN(Accept, "Accept")                                                       \
+    FN(AcceptCharset, "Accept-Charset")                                        \
+    FN(AcceptEncoding, "Accept-Encoding")                                      \
+    FN(AcceptLanguage, "Accept-Language")                                      \
+    FN(AcceptRanges, "Accept-Ranges")                                          \
+    FN(AccessControlAllowCredentials, "Access-Control-Allow-Credentials")      \
+    FN(AccessControlAllowHeaders, "Access-Control-Allow-Headers")              \
+    FN(AccessControlAllowMethods, "Access-Control-Allow-Methods")              \
+    FN(AccessControlAllowOrigin, "Access-Control-Allow-Origin")                \
+    FN(AccessControlExposeHeaders, "Access-Control-Expose-Headers")            \
+    FN(AccessControlMaxAge, "Access-Control-Max-Age")                          \
+    FN(AccessControlRequestHeaders, "Access-Control-Request-Headers")          \
+    FN(AccessControlRequestMethod, "Access-Control-Request-Method")            \
+    FN(Age, "Age")                                                             \
+    FN(Allow, "Allow")                                                         \
+    FN(Authorization, "Authorization")                                         \
+    FN(CacheControl, "Cache-Control")                                          \
+    FN(Connection, "Connection")                                               \
+    FN(ContentDisposition, "Content-Disposition")                              \
+    FN(ContentEncoding, "Content-Encoding")                                    \
+    FN(ContentLanguage, "Content-Language")                                    \
+    FN(ContentLength, "Content-Length")                                        \
+    FN(ContentLocation, "Content-Location")                                    \
+    FN(ContentRange, "Content-Range")                                          \
+    FN(ContentType, "Content-Type")                                            \
+    FN(Cookie, "Cookie")                                                       \
+    FN(Date, "Date")                                                           \
+    FN(Dnt, "DNT")                                                             \
+    FN(ETag, "ETag")                                                           \
+    FN(Expect, "Expect")                                                       \
+    FN(Expires, "Expires")                                                     \
+    FN(Forwarded, "Forwarded")                                                 \
+    FN(From, "From")                                                           \
+    FN(Host, "Host")                                                           \
+    FN(IfMatch, "If-Match")                                                    \
+    FN(IfModifiedSince, "If-Modified-Since")                                   \
+    FN(IfNoneMatch, "If-None-Match")                                           \
+    FN(IfRange, "If-Range")                                                    \
+    FN(IfUnmodifiedSince, "If-Unmodified-Since")                               \
+    FN(KeepAlive, "Keep-Alive")                                                \
+    FN(LastModified, "Last-Modified")                                          \
+    FN(Link, "Link")                                                           \
+    FN(Location, "Location")                                                   \
+    FN(MaxForwards, "Max-Forwards")                                            \
+    FN(Origin, "Origin")                                                       \
+    FN(Pragma, "Pragma")                                                       \
+    FN(ProxyAuthenticate, "Proxy-Authenticate")                                \
+    FN(ProxyAuthorization, "Proxy-Authorization")                              \
+    FN(Range, "Range")                                                         \
+    FN(Referer, "Referer")                                                     \
+    FN(RetryAfter, "Retry-After")                                              \
+    FN(Server, "Server")                                                       \
+    FN(SetCookie, "Set-Cookie")                                                \
+    FN(StrictTransportSecurity, "Strict-Transport-Security")                   \
+    FN(Te, "TE")                                                               \
+    FN(Trailer, "Trailer")                                                     \
+    FN(TransferEncoding, "Transfer-Encoding")                                  \
+    FN(Upgrade, "Upgrade")                                                     \
+    FN(UpgradeInsecureRequests, "Upgrade-Insecure-Requests")                   \
+    FN(UserAgent, "User-Agent")                                                \
+    FN(Vary, "Vary")                                                           \
+    FN(Via, "Via")                                                             \
+    FN(WwwAuthenticate, "WWW-Authenticate")                                    \
+    FN(Warning, "Warning")                                                     \
+    FN(XForwardedFor, "X-Forwarded-For")                                       \
+    FN(XForwardedHost, "X-Forwarded-Host")                                     \
+    FN(XForwardedProto, "X-Forwarded-Proto")                                   \
+    FN(XRealIp, "X-Real-IP")                                                   \
+    FN(XRequestedWith, "X-Requested-With")
+
+enum class HeaderId : uint8_t
+{
+#define fn(e, name) e,
+    HTTPP_APPLY_ON_HEADER(fn)
+#undef fn
+    Unknown
+};
+
+static constexpr size_t NB_HEADER_IDS = size_t(HeaderId::Unknown);
+
+std::string_view to_string(HeaderId id);
+// Case insensitive, HeaderId::Unknown if name is not a standard header.
+HeaderId header_id_from(std::string_view name) noexcept;
 
 } // namespace HTTP
 } // namespace HTTPP
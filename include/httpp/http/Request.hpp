@@ -11,11 +11,14 @@
 #ifndef _HTTPP_HTPP_REQUEST_HPP_
 #define _HTTPP_HTPP_REQUEST_HPP_
 
+#include <array>
 #include <chrono>
 #include <iosfwd>
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "Protocol.hpp"
 #include "httpp/utils/SortedVectorKP.hpp"
 #include <httpp/detail/config.hpp>
@@ -34,13 +37,42 @@ struct Request
     {
         query_params.reserve(10);
         headers.reserve(10);
+        header_ids.reserve(10);
     }
 
     void setDate();
     void clear();
 
+    // Called by the parsers: append a header and tag it with its id, then
+    // set its value, the typed fields below are filled when it is one of
+    // the framing headers. setHeaderValue returns false if the value is
+    // invalid.
+    void addHeader(std::string_view key);
+    bool setHeaderValue(std::string_view value);
+
+    // Value of the first header with this name, empty if there is none.
+    std::string_view header(HeaderId id) const noexcept;
+    // Case insensitive, for any header name.
+    std::string_view header(std::string_view name) const noexcept;
+
+    // Whether the connection should stay open once answered, from the
+    // Connection header or the HTTP version.
+    bool keepAlive() const noexcept;
+
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    // The buffer [begin, end) the request points to has been copied to to,
+    // make the views follow it.
+    void relocate(const char* begin, const char* end, const char* to);
+#endif
+
     TimePoint received = Clock::now();
     Method method;
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    // Only set for Method::EXTENSION
+    std::string_view method_name;
+#else
+    std::string method_name;
+#endif
 
 #if HTTPP_PARSER_BACKEND_IS_RAGEL
     std::string_view uri;
@@ -51,10 +83,34 @@ struct Request
     int major = 0;
     int minor = 0;
 
+    enum class ConnectionOption
+    {
+        Default,
+        Close,
+        KeepAlive,
+    };
+
+    // Framing headers, filled while parsing.
+    bool has_content_length = false;
+    size_t content_length = 0;
+    bool chunked = false;
+    ConnectionOption connection = ConnectionOption::Default;
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    std::string_view host;
+#else
+    std::string host;
+#endif
+
     using QueryParamRef = HTTP::QueryParamRef;
 
     std::vector<QueryParamRef> query_params;
 
+    // First query parameter with this (decoded) name, nullptr if there is
+    // none. The index behind it is built on the first call.
+    const QueryParamRef* findQueryParam(std::string_view key) const;
+    // Its value, empty if there is none.
+    const QueryParamRef::second_type& queryParam(std::string_view key) const;
+
     template <typename Comparator = std::less<QueryParamRef::first_type>>
     auto getSortedQueryParams() const
     {
@@ -63,6 +119,8 @@ struct Request
     }
 
     std::vector<HeaderRef> headers;
+    // header_ids[i] is the id of headers[i]
+    std::vector<HeaderId> header_ids;
 
     template <typename Comparator = std::less<HeaderRef::first_type>>
     auto getSortedHeaders() const
@@ -70,6 +128,20 @@ struct Request
         return UTILS::create_sorted_vector<HeaderRef::first_type, HeaderRef::second_type, Comparator>(headers
         );
     }
+
+private:
+    void indexQueryParams() const;
+    // The connection is closed after a request with both Content-Length and
+    // chunked Transfer-Encoding.
+    void close_if_ambiguous() noexcept;
+
+    // Position + 1 in headers of the first header of each id
+    std::array<uint16_t, NB_HEADER_IDS> header_index_ = {};
+
+    // Open addressing table of position + 1 in query_params, a power of 2
+    // in size, empty until the first lookup.
+    mutable boost::container::small_vector<uint16_t, 32> query_index_;
+    mutable size_t query_indexed_ = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, const Request& request);
@@ -11,15 +11,23 @@
 #ifndef _HTTPP_HTPP_RESPONSE_HPP_
 #define _HTTPP_HTPP_RESPONSE_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <ctime>
 #include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include <boost/asio.hpp>
 
 #include "Protocol.hpp"
+#include "helper/ChunkStream.hpp"
+#include "helper/Compression.hpp"
 
 namespace HTTPP
 {
@@ -28,8 +36,6 @@ namespace HTTP
 
 class Response
 {
-    static const char HTTP_START[9];
-    static const char SPACE[1];
     static const char HTTP_DELIMITER[2];
     static const char HEADER_SEPARATOR[2];
     static const char END_OF_STREAM_MARKER[5];
@@ -41,10 +47,19 @@ public:
     // empty string signifying the end of the response.
     using ChunkedResponseCallback = std::function<std::string_view()>;
 
+    // A part of the body written as is, owner keeps data alive until the
+    // response has been sent.
+    struct BodySegment
+    {
+        boost::asio::const_buffer data;
+        std::shared_ptr<const void> owner;
+    };
+
     Response() = default;
     Response(HttpCode code);
     Response(HttpCode code, std::string_view body);
     Response(HttpCode code, ChunkedResponseCallback&& callback);
+    ~Response();
 
     Response& setCode(HttpCode code)
     {
@@ -60,67 +75,142 @@ public:
     void clear();
 
     Response& addHeader(std::string k, std::string v);
+    // The body is copied.
     Response& setBody(std::string_view body);
+    Response& setBody(const char* body)
+    {
+        return setBody(std::string_view(body));
+    }
+
+    // The body is taken over or shared, none of these copy it.
+    Response& setBody(std::string&& body);
+    Response& setBody(std::vector<char>&& body);
+    Response& setBody(std::shared_ptr<const std::string> body);
+    // Add a segment after the body set so far.
+    Response& appendBody(BodySegment segment);
+
     Response& setBody(ChunkedResponseCallback callback);
+    // Chunked body pushed asynchronously by a producer.
+    Response& setBody(std::shared_ptr<helper::ChunkStream> stream);
+
+    // Chunks are gathered in one write up to max_bytes, waiting at most
+    // max_delay for more to be produced. The default delay of 0 writes what
+    // is ready right away, a ChunkStream can also be flushed.
+    static constexpr size_t DEFAULT_MAX_CHUNK_BYTES = 16 * 1024;
+    Response& setChunkCoalescing(size_t max_bytes, std::chrono::microseconds max_delay)
+    {
+        max_chunk_bytes_ = max_bytes;
+        max_chunk_delay_ = max_delay;
+        return *this;
+    }
 
-    template <typename Writer, typename WriteHandler>
-    void sendResponse(Writer& writer, WriteHandler&& writeHandler)
+    // The body is length bytes of the file from offset, written with
+    // sendfile(2) on a plain connection and read with pread(2) on an SSL
+    // one. The response owns fd, it is closed once sent.
+    Response& setBodyFile(int fd, uint64_t offset, uint64_t length);
+    // Serve the file at path, throws std::system_error if it cannot be
+    // opened. range is the request Range header: a single byte range is
+    // answered with PartialContent, or RequestedRangeNotSatisfiable when it
+    // is past the end; the whole file is sent for anything else.
+    Response& setBodyFile(const std::string& path, std::string_view range = {});
+
+    bool hasBodyFile() const noexcept
     {
-        using namespace std::string_view_literals;
-        buffers_.clear();
-        buffers_.reserve(5 + 1 + 4 * (headers_.size() + 1) + 1);
-
-        { // HTTP/1.1
-            buffers_.emplace_back(boost::asio::buffer(HTTP_START));
-            auto n = std::snprintf(code_str_, 4, "%i", int(code_));
-            buffers_.emplace_back(boost::asio::buffer(code_str_, n));
-            buffers_.emplace_back(boost::asio::buffer(SPACE));
-
-            auto message = getDefaultMessage(code_);
-            buffers_.emplace_back(boost::asio::buffer(message));
-        }
+        return file_ != nullptr;
+    }
 
-        buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
-        for (const auto& header : headers_)
-        {
-            buffers_.emplace_back(boost::asio::buffer(header.first));
-            buffers_.emplace_back(boost::asio::buffer(HEADER_SEPARATOR));
-            buffers_.emplace_back(boost::asio::buffer(header.second));
-            buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
-        }
+    // The size of the whole body, copied and segments.
+    size_t bodySize() const noexcept;
+
+    // Headers added by the server to every response, unless one of the same
+    // name has been set: the current Date when date is true, and
+    // server_line, a whole "Server: ...\r\n" line, when not empty. They are
+    // kept by clear().
+    void setDefaultHeaders(bool date, std::string_view server_line) noexcept
+    {
+        add_date_ = date;
+        server_line_ = server_line;
+    }
+
+    // Called by the server, when compression is enabled, with the coding
+    // the request accepts. The body is then compressed if its type and
+    // size are worth it. Reset by clear().
+    void setContentCoding(helper::ContentCoding coding, const helper::CompressionOptions& options) noexcept
+    {
+        coding_ = coding;
+        compression_ = options;
+        compression_enabled_ = true;
+    }
 
+    // Keep this response from being compressed, for a body the handler
+    // knows it would not shrink.
+    Response& setCompression(bool enabled) noexcept
+    {
+        compress_ = enabled;
+        return *this;
+    }
+
+    // Validators sent as the ETag and Last-Modified headers, the request
+    // preconditions are checked against them. A weak tag only says that
+    // the representations are equivalent. A compressed variant is sent with
+    // the coding appended to its tag, "tag-gzip", which If-None-Match also
+    // matches. Reset by clear().
+    Response& setETag(std::string_view tag, bool weak = false);
+    Response& setLastModified(std::time_t time) noexcept
+    {
+        last_modified_ = time;
+        return *this;
+    }
+
+    // Whether a request with these If-None-Match and If-Modified-Since
+    // headers already has this representation. If-None-Match wins when
+    // both are present.
+    bool isNotModified(std::string_view if_none_match, std::string_view if_modified_since) const noexcept;
+
+    // Answer NotModified with the headers and validators alone, the body
+    // set so far is dropped. Vary and the tag are those the full response
+    // would have had.
+    Response& setNotModified();
+
+    // pending is written first, in the same write: the responses queued
+    // for the previous pipelined requests.
+    template <typename Writer, typename WriteHandler>
+    void sendResponse(
+        Writer& writer,
+        WriteHandler&& writeHandler,
+        const std::vector<boost::asio::const_buffer>& pending = {}
+    )
+    {
+        prepare_buffers();
+        buffers_.insert(buffers_.begin(), pending.begin(), pending.end());
+
+        if (file_)
         {
-            if (is_chunked_enconding())
-            {
-                static const std::string_view te = "Transfer-Encoding"sv;
-                static const std::string_view chunked = "chunked"sv;
-                buffers_.emplace_back(boost::asio::buffer(te));
-                buffers_.emplace_back(boost::asio::buffer(HEADER_SEPARATOR));
-                buffers_.emplace_back(boost::asio::buffer(chunked));
-                buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
-            }
-            else
+            if constexpr (std::is_base_of_v<boost::asio::socket_base, Writer>)
             {
-                static const std::string_view cl = "Content-Length"sv;
-                buffers_.emplace_back(boost::asio::buffer(cl));
-                buffers_.emplace_back(boost::asio::buffer(HEADER_SEPARATOR));
-
-                auto n =
-                    std::snprintf(body_size_, sizeof(body_size_), "%zu", body_.size());
-                buffers_.emplace_back(boost::asio::buffer(body_size_, n));
-                buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
+                file_was_blocking_ = !writer.native_non_blocking();
             }
-        }
-
-        buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
 
-        if (!is_chunked_enconding())
+            // send headers, then the file.
+            boost::asio::async_write(
+                writer,
+                buffers_,
+                [this, &writer, writeHandler](const boost::system::error_code& ec, size_t size)
+                {
+                    if (ec)
+                    {
+                        writeHandler(ec, size);
+                    }
+                    else
+                    {
+                        write_file(writer, writeHandler);
+                    }
+                }
+            );
+        }
+        else if (!is_chunked_enconding())
         {
             // response is non-chunked, send everything at once.
-            if (!body_.empty())
-            {
-                buffers_.emplace_back(boost::asio::buffer(body_));
-            }
             boost::asio::async_write(writer, buffers_, writeHandler);
         }
         else
@@ -146,6 +236,26 @@ public:
         }
     }
 
+    // Append the whole response to out, to be written later along with
+    // others. Chunked and file responses cannot be serialized.
+    void serialize(std::vector<char>& out);
+
+    // A segment of a serialized body, written from where it is after the
+    // first offset bytes of out.
+    struct QueuedSegment
+    {
+        size_t offset;
+        BodySegment segment;
+    };
+    // Same, but the body segments are shared in segments instead of being
+    // copied to out.
+    void serialize(std::vector<char>& out, std::vector<QueuedSegment>& segments);
+
+    bool isChunked() const noexcept
+    {
+        return is_chunked_enconding();
+    }
+
     bool connectionShouldBeClosed() const
     {
         return should_be_closed_;
@@ -157,6 +267,7 @@ public:
         return *this;
     }
 
+    // The copied part of the body, followed by the segments.
     std::vector<char>& mutable_body() noexcept
     {
         return body_;
@@ -172,9 +283,17 @@ public:
         return code_ != HttpCode::Continue;
     }
 
+    // Stop the chunk stream being written, from any thread: a write waiting
+    // for its producer completes with operation_aborted.
+    void abortStream() noexcept;
+
 private:
-    // Sends individual chunks for a chunked response, until the end-of-stream
-    // is sent or an error occurs.
+    // Status line and headers serialized in head_, buffers_ is head_
+    // followed by the body and its segments when it is not chunked.
+    void prepare_buffers();
+
+    // Sends the chunks of a chunked response, until the end-of-stream is
+    // sent or an error occurs.
     template <typename Writer, typename WriteHandler>
     void write_chunk(Writer& writer, WriteHandler writeHandler)
     {
@@ -186,72 +305,324 @@ private:
             );
         }
 
-        // try to generate the next chunk. This may block.
-        current_chunk_ = chunkedBodyCallback_();
+        if (chunk_stream_)
+        {
+            write_stream(writer, writeHandler);
+            return;
+        }
 
-        if (!current_chunk_.empty())
+        // The callback is called again as long as the coalescing budget
+        // allows it. This may block.
+        bool last = false;
+        start_chunks();
+        auto deadline = std::chrono::steady_clock::now() + max_chunk_delay_;
+        for (;;)
         {
-            // Format the chunk header and chunk body.
-            buffers_.clear();
-            buffers_.reserve(4);
-
-            std::snprintf(
-                current_chunk_header_,
-                sizeof(current_chunk_header_),
-                "%zx",
-                current_chunk_.size()
-            );
+            auto chunk = chunkedBodyCallback_();
+            if (chunk.empty())
+            {
+                last = true;
+                break;
+            }
 
-            buffers_.emplace_back(boost::asio::buffer(current_chunk_header_));
-            buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
-            buffers_.emplace_back(boost::asio::buffer(current_chunk_));
-            buffers_.emplace_back(boost::asio::buffer(HTTP_DELIMITER));
+            // A large chunk is not copied, it is only valid until the next
+            // call.
+            if (!add_chunk(chunk, true) || pending_chunk_bytes() >= max_chunk_bytes_
+                || std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+        }
+
+        write_chunks(writer, writeHandler, last);
+    }
+
+    // Writes what the producer of chunk_stream_ has queued, all of it in one
+    // write, then waits for more without blocking until the stream is
+    // closed. With a delay, small chunks are held back until there are
+    // max_chunk_bytes_ of them, the delay expires or the producer flushes.
+    template <typename Writer, typename WriteHandler>
+    void write_stream(Writer& writer, WriteHandler writeHandler)
+    {
+        streaming_ = true;
+        stream_chunks_.clear();
+        auto min_bytes = max_chunk_delay_.count() ? max_chunk_bytes_ : 0;
+        auto status = chunk_stream_->take(
+            stream_chunks_,
+            min_bytes,
+            [this, &writer, writeHandler]
+            {
+                boost::asio::post(
+                    writer.get_executor(),
+                    [this, &writer, writeHandler]
+                    {
+                        write_stream(writer, writeHandler);
+                    }
+                );
+            }
+        );
+
+        if (status == helper::ChunkStream::Status::Pending)
+        {
+            if (!chunk_timer_armed_)
+            {
+                // The timer only holds the stream, it can outlive this
+                // response.
+                if (!chunk_timer_)
+                {
+                    chunk_timer_ = std::make_unique<boost::asio::steady_timer>(writer.get_executor());
+                }
+
+                chunk_timer_armed_ = true;
+                chunk_timer_->expires_after(max_chunk_delay_);
+                chunk_timer_->async_wait(
+                    [stream = chunk_stream_](const boost::system::error_code& ec)
+                    {
+                        if (!ec)
+                        {
+                            stream->flush();
+                        }
+                    }
+                );
+            }
+            return;
+        }
+
+        if (status == helper::ChunkStream::Status::Wait)
+        {
+            return;
+        }
+
+        if (chunk_timer_armed_)
+        {
+            chunk_timer_armed_ = false;
+            chunk_timer_->cancel();
+        }
+
+        if (status == helper::ChunkStream::Status::Failed)
+        {
+            streaming_ = false;
+            writeHandler(chunk_stream_->error(), 0);
+            return;
+        }
+
+        start_chunks();
+        for (const auto& chunk : stream_chunks_)
+        {
+            add_chunk(chunk, true);
+        }
+
+        bool last = status != helper::ChunkStream::Status::Data;
+        streaming_ = !last;
+        write_chunks(writer, writeHandler, last);
+    }
+
+    // Write the chunks added since start_chunks(), followed by the
+    // end-of-stream marker if last, then continue with the next ones.
+    template <typename Writer, typename WriteHandler>
+    void write_chunks(Writer& writer, WriteHandler writeHandler, bool last)
+    {
+        if (deflater_)
+        {
+            finish_compressed_chunk(last);
+        }
+
+        if (last)
+        {
+            add_end_of_stream();
+        }
+        prepare_chunk_buffers();
+
+        boost::asio::async_write(
+            writer,
+            buffers_,
+            [this, &writer, writeHandler, last](const boost::system::error_code& ec, size_t size)
+            {
+                if (ec || last)
+                {
+                    if (ec && streaming_)
+                    {
+                        streaming_ = false;
+                        chunk_stream_->fail(ec);
+                    }
+
+                    // notify the original caller that the response is
+                    // complete, or that an error occured during sending.
+                    writeHandler(ec, size);
+                }
+                else
+                {
+                    write_chunk(writer, writeHandler);
+                }
+            }
+        );
+    }
+
+    // Chunks are framed in coalesced_, the small ones copied there and the
+    // larger ones written from where they are when external is allowed.
+    // add_chunk returns false if chunk has not been copied. When the stream
+    // is compressed, the chunks go through deflater_ and what it produced is
+    // framed as one chunk before the write.
+    void start_chunks() noexcept;
+    void append_coalesced(const char* data, size_t size);
+    bool add_chunk(std::string_view chunk, bool external);
+    bool frame_chunk(std::string_view chunk, bool external);
+    void add_end_of_stream();
+    void finish_compressed_chunk(bool last);
+    // What the chunks added so far will take in the write, the compressed
+    // output when there is one.
+    size_t pending_chunk_bytes() const noexcept
+    {
+        return deflater_ ? compressed_.size() : coalesced_.size();
+    }
+
+    // Whether the body is worth compressing for some clients, these
+    // responses vary on Accept-Encoding.
+    bool should_compress(std::string_view content_type, bool has_encoding) const noexcept;
+    // Compress the body into compressed_, false if it does not shrink.
+    bool compress_body();
+    void prepare_chunk_buffers();
+
+    // Abort chunk_stream_ if it is still being written, this response no
+    // longer can.
+    void release_stream();
+
+    // Sends the file body until all of it is sent or an error occurs.
+    template <typename Writer, typename WriteHandler>
+    void write_file(Writer& writer, WriteHandler writeHandler)
+    {
+        if constexpr (std::is_base_of_v<boost::asio::socket_base, Writer>)
+        {
+            boost::system::error_code ec;
+            writer.native_non_blocking(true, ec);
+            if (!ec)
+            {
+                ec = send_file(writer.native_handle());
+            }
+
+            if (ec == boost::asio::error::would_block)
+            {
+                writer.async_wait(
+                    Writer::wait_write,
+                    [this, &writer, writeHandler](const boost::system::error_code& ec)
+                    {
+                        if (ec)
+                        {
+                            writeHandler(ec, 0);
+                        }
+                        else
+                        {
+                            write_file(writer, writeHandler);
+                        }
+                    }
+                );
+                return;
+            }
+
+            if (file_was_blocking_)
+            {
+                boost::system::error_code ignored;
+                writer.native_non_blocking(false, ignored);
+            }
+            writeHandler(ec, 0);
+        }
+        else
+        {
+            auto ec = read_file_chunk();
+            if (ec || file_chunk_.empty())
+            {
+                writeHandler(ec, 0);
+                return;
+            }
 
             boost::asio::async_write(
                 writer,
-                buffers_,
+                boost::asio::buffer(file_chunk_),
                 [this, &writer, writeHandler](const boost::system::error_code& ec, size_t size)
                 {
                     if (ec)
                     {
-                        // notify the original caller that an error occured
-                        // during sending.
                         writeHandler(ec, size);
                     }
                     else
                     {
-                        // write the next chunk.
-                        write_chunk(writer, writeHandler);
+                        write_file(writer, writeHandler);
                     }
                 }
             );
         }
-        else
-        {
-            // Send end of stream marker, notify the client handler that the
-            // response is complete, potentially with an error if the
-            // this write fails.
-            boost::asio::async_write(writer, boost::asio::buffer(END_OF_STREAM_MARKER), writeHandler);
-        }
     }
 
+    // sendfile(2) to socket until the file is sent, would_block when the
+    // socket cannot take more.
+    boost::system::error_code send_file(int socket);
+    // The next part of the file in file_chunk_, empty once it is all sent.
+    boost::system::error_code read_file_chunk();
+
     bool is_chunked_enconding() const
     {
-        return chunkedBodyCallback_ != nullptr;
+        return chunkedBodyCallback_ != nullptr || chunk_stream_ != nullptr;
     }
 
 private:
     std::vector<boost::asio::const_buffer> buffers_;
+    std::vector<char> head_;
     HttpCode code_ = HttpCode::Ok;
-    char code_str_[4];
 
     std::vector<char> body_;
-    char body_size_[16];
+    std::vector<BodySegment> segments_;
+
+    struct BodyFile;
+    std::shared_ptr<BodyFile> file_;
+    uint64_t file_begin_ = 0;
+    uint64_t file_end_ = 0;
+    // Next byte of the file to send
+    uint64_t file_offset_ = 0;
+    std::vector<char> file_chunk_;
+    // sendfile(2) needs a non-blocking socket, it is put back in blocking
+    // mode once the file is sent when it was in that mode before.
+    bool file_was_blocking_ = false;
+
     ChunkedResponseCallback chunkedBodyCallback_;
-    char current_chunk_header_[16];
-    std::string_view current_chunk_;
+    std::shared_ptr<helper::ChunkStream> chunk_stream_;
+    // Chunks taken from chunk_stream_ being written
+    std::vector<std::string> stream_chunks_;
+
+    // Framing and small chunks of the next write, with where the larger
+    // chunks go in between: data is null for a part of coalesced_.
+    struct ChunkPiece
+    {
+        const char* data;
+        size_t offset;
+        size_t size;
+    };
+    std::vector<char> coalesced_;
+    std::vector<ChunkPiece> chunk_pieces_;
+    size_t max_chunk_bytes_ = DEFAULT_MAX_CHUNK_BYTES;
+    std::chrono::microseconds max_chunk_delay_ = {};
+    std::unique_ptr<boost::asio::steady_timer> chunk_timer_;
+    bool chunk_timer_armed_ = false;
+
+    helper::ContentCoding coding_ = helper::ContentCoding::Identity;
+    helper::CompressionOptions compression_;
+    bool compression_enabled_ = false;
+    bool compress_ = true;
+    // Compressed body, or what the stream compressed for the next write
+    std::vector<char> compressed_;
+    bool body_compressed_ = false;
+    std::unique_ptr<helper::Deflater> deflater_;
+    // Between the headers and the end of chunk_stream_, read by
+    // abortStream from other threads.
+    std::atomic_bool streaming_ = {false};
     std::vector<Header> headers_;
+    // Formatted entity tag, quoted, and -1 for no Last-Modified
+    std::string etag_;
+    std::time_t last_modified_ = -1;
+    // Size of the body dropped by setNotModified, SIZE_MAX for a chunked one
+    size_t not_modified_size_ = 0;
     bool should_be_closed_ = false;
+    bool add_date_ = false;
+    std::string_view server_line_;
     std::string status_string_;
 };
 
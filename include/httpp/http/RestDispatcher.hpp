@@ -12,12 +12,14 @@
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <stdexcept>
 
 #include <boost/container/flat_map.hpp>
 #include <commonpp/core/Utils.hpp>
 
 #include "Protocol.hpp"
+#include "StaticResponse.hpp"
 #include "helper/ReadWholeRequest.hpp"
 
 namespace HTTPP
@@ -38,7 +40,7 @@ struct Route
         WithoutBody,
     };
 
-    using AllowedMethod = std::array<bool, 8>;
+    using AllowedMethod = std::array<bool, HTTP::NB_METHODS>;
     using WithoutBodyHandler = std::function<void(HTTP::Connection*)>;
     using WithBodyHandler = std::function<void(HTTP::helper::ReadWholeRequest::Handle)>;
 
@@ -98,6 +100,13 @@ public:
         table_.emplace(std::move(path), std::move(route));
     }
 
+    // Serve response, built once, to every request on path.
+    template <HTTP::Method... method>
+    void add(std::string path, std::shared_ptr<const StaticResponse> response)
+    {
+        add<method...>(std::move(path), serve(std::move(response)));
+    }
+
     size_t size() const
     {
         return table_.size();
@@ -105,6 +114,7 @@ public:
 
 private:
     void sink(HTTP::Connection* conn);
+    static Route::WithoutBodyHandler serve(std::shared_ptr<const StaticResponse> response);
 
 private:
     HttpServer& server_;
@@ -0,0 +1,62 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#ifndef _HTTPP_HTPP_STATIC_RESPONSE_HPP_
+#define _HTTPP_HTPP_STATIC_RESPONSE_HPP_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Protocol.hpp"
+#include "helper/Compression.hpp"
+
+namespace HTTPP
+{
+namespace HTTP
+{
+
+struct Request;
+class Response;
+
+// An immutable response built once and served to many requests. Its body
+// is compressed ahead of time with every coding that makes it smaller, each
+// request gets the best variant it accepts without copying it. Each variant
+// has its own entity tag, derived from the body or from the ETag header
+// given, so that conditional requests are answered with NotModified.
+class StaticResponse
+{
+public:
+    StaticResponse(HttpCode code, std::string body, std::vector<Header> headers = {});
+
+    // Make response this one, for request.
+    void apply(const Request& request, Response& response) const;
+
+    // The body with this coding, null if it is not kept.
+    const std::shared_ptr<const std::string>& body(helper::ContentCoding coding) const noexcept
+    {
+        return bodies_[size_t(coding)];
+    }
+
+private:
+    HttpCode code_;
+    std::vector<Header> headers_;
+    // Whether there are compressed variants
+    bool vary_ = false;
+    std::array<std::shared_ptr<const std::string>, helper::NB_CONTENT_CODINGS> bodies_;
+    std::array<std::string, helper::NB_CONTENT_CODINGS> etags_;
+    bool weak_etag_ = false;
+};
+
+} // namespace HTTP
+} // namespace HTTPP
+
+#endif // !_HTTPP_HTPP_STATIC_RESPONSE_HPP_
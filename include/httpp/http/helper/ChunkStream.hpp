@@ -0,0 +1,111 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#ifndef _HTTPP_HTPP_HELPER_CHUNK_STREAM_HPP_
+#define _HTTPP_HTPP_HELPER_CHUNK_STREAM_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/system/error_code.hpp>
+
+namespace HTTPP
+{
+namespace HTTP
+{
+
+class Response;
+
+namespace helper
+{
+
+// Body of a chunked response pushed by its producer as it becomes
+// available, from any thread. The chunks are written by the I/O thread
+// without waiting on the producer.
+class ChunkStream
+{
+public:
+    static constexpr size_t DEFAULT_MAX_QUEUED = 256 * 1024;
+
+    // Called once the producer can push again, or with an error when the
+    // response will not be sent further. It runs on the I/O thread and
+    // should not block.
+    using ReadyCallback = std::function<void(const boost::system::error_code&)>;
+
+    explicit ChunkStream(size_t max_queued = DEFAULT_MAX_QUEUED);
+
+    ChunkStream(const ChunkStream&) = delete;
+    ChunkStream& operator=(const ChunkStream&) = delete;
+
+    // Queue a chunk, an empty one is ignored. Returns false once max_queued
+    // bytes are waiting to be written or the response has failed: the
+    // producer should stop until the ready callback is called. flush asks
+    // for what is queued to be written without waiting for more.
+    bool push(std::string chunk, bool flush = false);
+    void flush();
+    // End of the body, what is queued is still written.
+    void close();
+
+    void onReady(ReadyCallback callback);
+
+    // The error that stopped the response, if any
+    boost::system::error_code error() const;
+
+private:
+    friend class ::HTTPP::HTTP::Response;
+
+    enum class Status
+    {
+        Data,
+        // The data taken is the end of the stream
+        Last,
+        // Less than min_bytes are queued
+        Pending,
+        Wait,
+        End,
+        // The stream has been aborted
+        Failed,
+    };
+
+    // Move the queued chunks to out, once there are at least min_bytes of
+    // them or a flush is requested. On Pending or Wait, wakeup is called
+    // once they can be taken.
+    Status take(std::vector<std::string>& out, size_t min_bytes, std::function<void()> wakeup);
+    // The response stopped, the producer is told with ec.
+    void fail(const boost::system::error_code& ec);
+    // Fail it from any other thread, a writer waiting for chunks is woken
+    // to see the error.
+    void abort(const boost::system::error_code& ec);
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<std::string> queue_;
+    size_t queued_ = 0;
+    size_t max_queued_;
+    bool closed_ = false;
+    // push returned false, the producer waits for ready_
+    bool full_ = false;
+    bool flush_ = false;
+    // Queued bytes from which wakeup_ is called
+    size_t wakeup_bytes_ = 0;
+    boost::system::error_code error_;
+    std::function<void()> wakeup_;
+    ReadyCallback ready_;
+};
+
+} // namespace helper
+} // namespace HTTP
+} // namespace HTTPP
+
+#endif // !_HTTPP_HTPP_HELPER_CHUNK_STREAM_HPP_
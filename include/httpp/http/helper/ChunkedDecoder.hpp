@@ -0,0 +1,69 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#ifndef _HTTPP_HTPP_HELPER_CHUNKED_DECODER_HPP_
+#define _HTTPP_HTPP_HELPER_CHUNKED_DECODER_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+namespace HTTPP
+{
+namespace HTTP
+{
+namespace helper
+{
+
+// Incremental decoder of a chunked transfer-encoded body. The input can be
+// split anywhere, the payload is returned as views on the input.
+class ChunkedDecoder
+{
+public:
+    enum class Status
+    {
+        NeedMore,
+        Data,
+        Done,
+        Error,
+    };
+
+    // Decode from data up to end, data is advanced past what has been
+    // consumed. On Data, chunk is the next part of the payload.
+    Status decode(const char*& data, const char* end, std::string_view& chunk);
+
+    void reset() noexcept;
+
+private:
+    enum class State
+    {
+        Size,
+        Extension,
+        SizeLF,
+        Data,
+        DataCR,
+        DataLF,
+        Trailer,
+        TrailerLine,
+        TrailerLineLF,
+        EndLF,
+        Done,
+        Error,
+    };
+
+    State state_ = State::Size;
+    size_t remaining_ = 0;
+    size_t digits_ = 0;
+};
+
+} // namespace helper
+} // namespace HTTP
+} // namespace HTTPP
+
+#endif // !_HTTPP_HTPP_HELPER_CHUNKED_DECODER_HPP_
@@ -0,0 +1,101 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#ifndef _HTTPP_HTPP_HELPER_COMPRESSION_HPP_
+#define _HTTPP_HTPP_HELPER_COMPRESSION_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace HTTPP
+{
+namespace HTTP
+{
+namespace helper
+{
+
+enum class ContentCoding : uint8_t
+{
+    Identity,
+    Gzip,
+    Deflate,
+    // Only for content compressed ahead of time, see StaticResponse
+    Brotli,
+};
+
+static constexpr size_t NB_CONTENT_CODINGS = size_t(ContentCoding::Brotli) + 1;
+
+std::string_view to_string(ContentCoding coding);
+
+// The coding to use for a request with this Accept-Encoding header, br
+// when allowed then gzip are preferred to deflate for the same quality.
+ContentCoding negotiate_coding(std::string_view accept_encoding, bool brotli = false) noexcept;
+// Only among the codings available, indexed by ContentCoding. Identity is
+// chosen when none of them is acceptable.
+using AvailableCodings = std::array<bool, NB_CONTENT_CODINGS>;
+ContentCoding negotiate_coding(std::string_view accept_encoding, const AvailableCodings& available) noexcept;
+
+// Whether a body of this Content-Type is worth compressing, false for
+// media types already compressed. A missing type is assumed to be.
+bool is_compressible(std::string_view content_type) noexcept;
+
+struct CompressionOptions
+{
+    // zlib level, from 1 (fastest) to 9 (smallest)
+    int level = 6;
+    // Smaller bodies are sent as they are, chunked ones are always
+    // compressed.
+    size_t min_size = 1024;
+};
+
+// zlib deflate stream producing gzip or deflate data. They are kept in a
+// per-thread pool to be reused without allocating their state again.
+class Deflater
+{
+public:
+    static std::unique_ptr<Deflater> acquire(ContentCoding coding, int level);
+    static void release(std::unique_ptr<Deflater> deflater) noexcept;
+
+    ~Deflater();
+
+    Deflater(const Deflater&) = delete;
+    Deflater& operator=(const Deflater&) = delete;
+
+    // Compress in and append what is produced to out. With flush, all of it
+    // is output so that the receiver can decode it, and with finish the
+    // stream ends.
+    void compress(std::string_view in, std::vector<char>& out, bool flush, bool finish);
+
+    // Start a new stream
+    void reset() noexcept;
+
+    ContentCoding coding() const noexcept
+    {
+        return coding_;
+    }
+
+private:
+    Deflater(ContentCoding coding, int level);
+
+    struct Stream;
+    std::unique_ptr<Stream> stream_;
+    ContentCoding coding_;
+    int level_;
+};
+
+} // namespace helper
+} // namespace HTTP
+} // namespace HTTPP
+
+#endif // !_HTTPP_HTPP_HELPER_COMPRESSION_HPP_
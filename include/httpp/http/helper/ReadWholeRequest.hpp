@@ -26,12 +26,16 @@ struct ReadWholeRequest
 
     void start();
     void operator()(const boost::system::error_code& errc);
+    // Chunked body
+    void operator()(const boost::system::error_code& errc, const char* data, size_t n);
+    void entity_too_large();
 
     Connection* connection;
     Callback cb;
     std::unique_ptr<std::vector<char>> fallback;
     std::vector<char>& body;
     size_t size_limit = 0;
+    bool too_large = false;
 };
 
 } // namespace helper
@@ -12,8 +12,10 @@
 #ifndef HTTPP_UTILS_LAZYDECODEDVALUE_HPP
 #define HTTPP_UTILS_LAZYDECODEDVALUE_HPP
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <string_view>
 
 namespace HTTPP
 {
@@ -34,15 +36,28 @@ public:
     LazyDecodedValue& operator=(const LazyDecodedValue&) = default;
     LazyDecodedValue& operator=(LazyDecodedValue&&) = default;
 
-    bool operator==(const LazyDecodedValue& rhs) const noexcept;
+    // Compare and order on the decoded values
+    bool operator==(const LazyDecodedValue& rhs) const;
+    bool operator<(const LazyDecodedValue& rhs) const;
 
     operator const std::string&() const;
     const std::string& string() const;
 
+    // The decoded value, the raw one itself when it has nothing to decode.
+    std::string_view view() const;
+
     std::string_view raw() const noexcept;
 
 private:
+    enum class Decoding : uint8_t
+    {
+        Pending,
+        NotNeeded,
+        Done,
+    };
+
     std::string_view raw_value_;
+    mutable Decoding decoding_ = Decoding::Pending;
     mutable std::string decoded_value_;
 };
 
@@ -0,0 +1,123 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#ifndef _HTTPP_UTILS_SHARDED_INTRUSIVE_LIST_HPP_
+#define _HTTPP_UTILS_SHARDED_INTRUSIVE_LIST_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <boost/intrusive/list.hpp>
+
+namespace HTTPP
+{
+namespace UTILS
+{
+
+using ShardedListHook = boost::intrusive::list_member_hook<>;
+
+// Small index identifying the calling thread, assigned on first call. Used
+// to pick the shard of the sharded structures.
+inline size_t current_thread_index() noexcept
+{
+    static std::atomic<size_t> next_index = {0};
+    static thread_local size_t index = next_index++;
+    return index;
+}
+
+// Intrusive list split in several shards, each protected by its own mutex.
+// An element is inserted in the shard of the calling thread and removed in
+// O(1) from the shard it has been inserted into (possibly from another
+// thread), so threads only contend when they touch the same shard.
+//
+// The list never owns the elements.
+template <typename T, ShardedListHook T::*Hook>
+class ShardedIntrusiveList
+{
+    using List = boost::intrusive::list<
+        T,
+        boost::intrusive::member_hook<T, ShardedListHook, Hook>,
+        boost::intrusive::constant_time_size<false>>;
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        List list;
+    };
+
+public:
+    explicit ShardedIntrusiveList(size_t nb_shards)
+    : nb_shards_(std::max<size_t>(nb_shards, 1))
+    , shards_(new Shard[nb_shards_])
+    {
+    }
+
+    ~ShardedIntrusiveList()
+    {
+        for (size_t i = 0; i < nb_shards_; ++i)
+        {
+            shards_[i].list.clear();
+        }
+    }
+
+    ShardedIntrusiveList(const ShardedIntrusiveList&) = delete;
+    ShardedIntrusiveList& operator=(const ShardedIntrusiveList&) = delete;
+
+    // Return the shard the element has been inserted into, it is required
+    // to remove it.
+    size_t insert(T& value)
+    {
+        auto shard_idx = current_thread_index() % nb_shards_;
+        auto& shard = shards_[shard_idx];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.list.push_back(value);
+        return shard_idx;
+    }
+
+    // Return false if the element was not in the list.
+    bool erase(T& value, size_t shard_idx)
+    {
+        auto& shard = shards_[shard_idx];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!((value.*Hook).is_linked()))
+        {
+            return false;
+        }
+
+        shard.list.erase(shard.list.iterator_to(value));
+        return true;
+    }
+
+    // Each shard is locked while its elements are visited.
+    template <typename Callable>
+    void for_each(Callable&& callable)
+    {
+        for (size_t i = 0; i < nb_shards_; ++i)
+        {
+            auto& shard = shards_[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto& value : shard.list)
+            {
+                callable(value);
+            }
+        }
+    }
+
+private:
+    const size_t nb_shards_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace UTILS
+} // namespace HTTPP
+
+#endif // !_HTTPP_UTILS_SHARDED_INTRUSIVE_LIST_HPP_
@@ -11,6 +11,8 @@
 #ifndef _HTTPP_UTILS_URL_HPP_
 #define _HTTPP_UTILS_URL_HPP_
 
+#include <string>
+
 #include <commonpp/net/http/URL.hpp>
 
 namespace HTTPP
@@ -20,6 +22,13 @@ namespace UTILS
 using commonpp::net::http::url_decode;
 using commonpp::net::http::url_encode;
 
+// First '%' or '+' in [begin, end), end if the value has nothing to decode.
+const char* find_url_escape(const char* begin, const char* end) noexcept;
+
+// Decode [begin, end) into out, '+' is a space and invalid escapes are
+// kept as they are.
+void url_decode(const char* begin, const char* end, std::string& out);
+
 } // namespace UTILS
 } // namespace HTTPP
 
@@ -10,6 +10,9 @@
 
 #include "httpp/HttpServer.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include "httpp/http/Connection.hpp"
 #include "httpp/http/Request.hpp"
 #include "httpp/http/Utils.hpp"
@@ -23,78 +26,163 @@ CREATE_LOGGER(server_logger, "httpp::HttpServer");
 using AsioAcceptor =
     boost::asio::basic_socket_acceptor<boost::asio::ip::tcp, boost::asio::io_context::executor_type>;
 
+#ifdef SO_REUSEPORT
+using ReusePort = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
 struct HttpServer::Acceptor : AsioAcceptor
 {
-    Acceptor(boost::asio::io_service& service)
-    : AsioAcceptor(service)
+    Acceptor(ThreadPool& pool)
+    : AsioAcceptor(pool.getService())
+    , pool(pool)
+    {
+    }
+
+    // Connections accepted by this acceptor are served by this pool.
+    ThreadPool& pool;
+    // Several accepts can be in flight and complete on different threads.
+    std::mutex mutex;
+    std::shared_ptr<boost::asio::ssl::context> ssl_ctx;
+};
+
+struct HttpServer::ConnectionRegistry
+: UTILS::ShardedIntrusiveList<HTTP::Connection, &HTTP::Connection::registry_hook_>
+{
+    ConnectionRegistry()
+    : ShardedIntrusiveList(std::thread::hardware_concurrency())
     {
     }
+};
+
+struct HttpServer::ConnectionPool
+{
+    static constexpr size_t DEFAULT_MAX_POOLED = 128;
+    static constexpr size_t DEFAULT_MAX_BUFFER_SIZE = 64 * 1024;
 
-    void setSSLContext(SSLContext ctx)
+    struct alignas(64) Shard
     {
-        ssl_ctx.reset(new boost::asio::ssl::context(boost::asio::ssl::context::sslv23));
-        if (!((ctx.cert_file.empty() ^ ctx.cert_buffer.empty())
-              && (ctx.key_file.empty() ^ ctx.key_buffer.empty())))
+        std::mutex mutex;
+        std::vector<ConnectionPtr> connections;
+    };
+
+    ConnectionPool()
+    : nb_shards(std::max(std::thread::hardware_concurrency(), 1u))
+    , shards(new Shard[nb_shards])
+    {
+    }
+
+    ~ConnectionPool()
+    {
+        for (size_t i = 0; i < nb_shards; ++i)
         {
-            throw std::invalid_argument("Cert and Key file/buffer are required");
+            for (auto connection : shards[i].connections)
+            {
+                delete connection;
+            }
         }
+    }
+
+    Shard& current_shard()
+    {
+        return shards[UTILS::current_thread_index() % nb_shards];
+    }
 
-        auto flags =
-            boost::asio::ssl::context::default_workarounds
-            | boost::asio::ssl::context::no_sslv2 | boost::asio::ssl::context::no_sslv3 |
+    size_t max_pooled = DEFAULT_MAX_POOLED;
+    size_t max_buffer_size = DEFAULT_MAX_BUFFER_SIZE;
+    const size_t nb_shards;
+    std::unique_ptr<Shard[]> shards;
+};
+
+static std::shared_ptr<boost::asio::ssl::context> make_ssl_context(HttpServer::SSLContext ctx)
+{
+    auto ssl_ctx =
+        std::make_shared<boost::asio::ssl::context>(boost::asio::ssl::context::sslv23);
+    if (!((ctx.cert_file.empty() ^ ctx.cert_buffer.empty())
+          && (ctx.key_file.empty() ^ ctx.key_buffer.empty())))
+    {
+        throw std::invalid_argument("Cert and Key file/buffer are required");
+    }
+
+    auto flags =
+        boost::asio::ssl::context::default_workarounds
+        | boost::asio::ssl::context::no_sslv2 | boost::asio::ssl::context::no_sslv3 |
 #ifndef __APPLE__
-            boost::asio::ssl::context::no_tlsv1 |
+        boost::asio::ssl::context::no_tlsv1 |
 #endif
-            boost::asio::ssl::context::single_dh_use;
+        boost::asio::ssl::context::single_dh_use;
 
-        ssl_ctx->set_options(flags);
+    ssl_ctx->set_options(flags);
 
-        if (!ctx.cert_file.empty())
-        {
-            ssl_ctx->use_certificate_file(ctx.cert_file, boost::asio::ssl::context::pem);
-        }
-        else
-        {
-            ssl_ctx->use_certificate(
-                boost::asio::buffer(ctx.cert_buffer), boost::asio::ssl::context::pem
-            );
-        }
+    if (!ctx.cert_file.empty())
+    {
+        ssl_ctx->use_certificate_file(ctx.cert_file, boost::asio::ssl::context::pem);
+    }
+    else
+    {
+        ssl_ctx->use_certificate(
+            boost::asio::buffer(ctx.cert_buffer), boost::asio::ssl::context::pem
+        );
+    }
 
-        if (!ctx.key_file.empty())
-        {
-            ssl_ctx->use_private_key_file(ctx.key_file, boost::asio::ssl::context::pem);
-        }
-        else
-        {
-            ssl_ctx->use_private_key(
-                boost::asio::buffer(ctx.key_buffer), boost::asio::ssl::context::pem
-            );
-        }
+    if (!ctx.key_file.empty())
+    {
+        ssl_ctx->use_private_key_file(ctx.key_file, boost::asio::ssl::context::pem);
+    }
+    else
+    {
+        ssl_ctx->use_private_key(
+            boost::asio::buffer(ctx.key_buffer), boost::asio::ssl::context::pem
+        );
+    }
 
-        if (!ctx.dh_file.empty())
-        {
-            ssl_ctx->use_tmp_dh_file(ctx.dh_file);
-        }
-        else if (!ctx.dh_buffer.empty())
-        {
-            ssl_ctx->use_tmp_dh(boost::asio::buffer(ctx.dh_buffer));
-        }
+    if (!ctx.dh_file.empty())
+    {
+        ssl_ctx->use_tmp_dh_file(ctx.dh_file);
+    }
+    else if (!ctx.dh_buffer.empty())
+    {
+        ssl_ctx->use_tmp_dh(boost::asio::buffer(ctx.dh_buffer));
     }
 
-    std::unique_ptr<boost::asio::ssl::context> ssl_ctx;
-};
+    return ssl_ctx;
+}
 
 HttpServer::HttpServer(size_t threads)
-: pool_(std::make_shared<ThreadPool>(threads))
+: pools_{std::make_shared<ThreadPool>(threads)}
+, connections_(new ConnectionRegistry())
+, connection_pool_(new ConnectionPool())
 {
 }
 
+HttpServer::HttpServer(size_t threads, Sharded)
+: sharded_(true)
+, connections_(new ConnectionRegistry())
+, connection_pool_(new ConnectionPool())
+{
+#ifndef SO_REUSEPORT
+    throw std::logic_error("Sharded mode requires SO_REUSEPORT support");
+#endif
+
+    if (!threads)
+    {
+        throw std::invalid_argument("Sharded mode requires at least one thread");
+    }
+
+    pools_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        pools_.emplace_back(std::make_shared<ThreadPool>(1));
+    }
+}
+
 static void empty_deleter(commonpp::thread::ThreadPool*)
 {
 }
 
 HttpServer::HttpServer(ThreadPool& pool)
-: pool_(std::addressof(pool), &empty_deleter)
+: pools_{std::shared_ptr<ThreadPool>(std::addressof(pool), &empty_deleter)}
+, connections_(new ConnectionRegistry())
+, connection_pool_(new ConnectionPool())
 {
 }
 
@@ -113,13 +201,17 @@ void HttpServer::start(ThreadInit fct)
         return;
     }
     running_ = true;
-    pool_->start(fct);
+    for (auto& pool : pools_)
+    {
+        pool->start(fct);
+    }
 }
 
 void HttpServer::stopListeners()
 {
     for (auto acc : acceptors_)
     {
+        std::lock_guard<std::mutex> lock(acc->mutex);
         boost::system::error_code ec;
         acc->cancel(ec);
         acc->close(ec);
@@ -133,6 +225,47 @@ void HttpServer::stopListeners()
     }
 }
 
+std::vector<boost::asio::ip::tcp::endpoint> HttpServer::getListeningEndpoints() const
+{
+    std::vector<boost::asio::ip::tcp::endpoint> endpoints;
+    for (const auto& acc : acceptors_)
+    {
+        std::lock_guard<std::mutex> lock(acc->mutex);
+        boost::system::error_code ec;
+        auto endpoint = acc->local_endpoint(ec);
+        if (!ec)
+        {
+            endpoints.push_back(endpoint);
+        }
+    }
+    return endpoints;
+}
+
+void HttpServer::setAcceptDepth(size_t depth)
+{
+    if (!depth)
+    {
+        throw std::invalid_argument("Accept depth must be at least 1");
+    }
+
+    accept_depth_ = depth;
+}
+
+void HttpServer::setConnectionPool(size_t max_pooled, size_t max_buffer_size)
+{
+    connection_pool_->max_pooled = max_pooled;
+    connection_pool_->max_buffer_size = max_buffer_size;
+}
+
+void HttpServer::setServerName(std::string_view name)
+{
+    server_header_.clear();
+    if (!name.empty())
+    {
+        server_header_.append("Server: ").append(name).append("\r\n");
+    }
+}
+
 void HttpServer::eventHandler(EventHandler& hndl)
 {
     ev_hndl_ = std::addressof(hndl);
@@ -149,39 +282,41 @@ void HttpServer::stop()
 
     stopListeners();
 
-    {
-        std::lock_guard<std::mutex> lock(connections_mutex_);
-        for (auto connection : connections_)
+    connections_->for_each(
+        [](HTTP::Connection& connection)
         {
-            connection->markToBeDeleted();
+            connection.markToBeDeleted();
         }
-    }
+    );
 
     while (connection_count_)
     {
         std::this_thread::yield();
     }
 
-    pool_->stop();
+    for (auto& pool : pools_)
+    {
+        pool->stop();
+    }
 }
 
 void HttpServer::bind(const std::string& address, const std::string& port)
 {
-    if (not running_)
-    {
-        throw std::logic_error(
-            "Http server must be started before bind is called"
-        );
-    }
-
-    auto acc = HttpServer::bind(pool_->getService(), address, port);
+    bind(address, port, nullptr);
     LOG(server_logger, debug) << "Bind address: " << address << " on port: " << port;
-    acceptors_.push_back(acc);
-    ++running_acceptors_;
-    start_accept(acc);
 }
 
 void HttpServer::bind(const std::string& address, SSLContext ctx, const std::string& port)
+{
+    bind(address, port, make_ssl_context(std::move(ctx)));
+    LOG(server_logger, debug) << "SSL bind address: " << address << " on port: " << port;
+}
+
+void HttpServer::bind(
+    const std::string& address,
+    const std::string& port,
+    std::shared_ptr<boost::asio::ssl::context> ssl_ctx
+)
 {
     if (not running_)
     {
@@ -190,19 +325,36 @@ void HttpServer::bind(const std::string& address, SSLContext ctx, const std::str
         );
     }
 
-    auto acc = HttpServer::bind(pool_->getService(), address, port);
-    acc->setSSLContext(std::move(ctx));
-    LOG(server_logger, debug) << "SSL bind address: " << address << " on port: " << port;
-    acceptors_.push_back(acc);
-    ++running_acceptors_;
-    start_accept(acc);
+    // In sharded mode every shard gets its own listening socket on the same
+    // address and the kernel balances the incoming connections between them.
+    std::vector<AcceptorPtr> acceptors;
+    acceptors.reserve(pools_.size());
+    auto bound_port = port;
+    for (auto& pool : pools_)
+    {
+        auto acc = HttpServer::bind(*pool, address, bound_port, sharded_);
+        acc->ssl_ctx = ssl_ctx;
+        // With port 0 the first listener gets one from the system, the
+        // other shards have to listen on the same.
+        bound_port = std::to_string(acc->local_endpoint().port());
+        acceptors.emplace_back(std::move(acc));
+    }
+
+    for (auto& acc : acceptors)
+    {
+        acceptors_.push_back(acc);
+        running_acceptors_ += accept_depth_;
+        for (size_t i = 0; i < accept_depth_; ++i)
+        {
+            start_accept(acc);
+        }
+    }
 }
 
 void HttpServer::mark(ConnectionPtr connection)
 {
     ++connection_count_;
-    std::lock_guard<std::mutex> lock(connections_mutex_);
-    connections_.emplace_back(connection);
+    connection->registry_shard_ = connections_->insert(*connection);
 
     if (ev_hndl_)
     {
@@ -214,56 +366,97 @@ void HttpServer::destroy(ConnectionPtr connection, bool release)
 {
     connection->markToBeDeleted();
 
+    if (!connections_->erase(*connection, connection->registry_shard_))
     {
-        std::lock_guard<std::mutex> lock(connections_mutex_);
-        auto it = std::find_if(
-            std::begin(connections_),
-            std::end(connections_),
-            [&](ConnectionPtr conn)
-            {
-                return connection == conn;
-            }
-        );
-        if (it == std::end(connections_))
+        return;
+    }
+
+    --connection_count_;
+    if (ev_hndl_)
+    {
+        ev_hndl_->connection_destroyed(connection);
+    }
+
+    if (release)
+    {
+        release_connection(connection);
+    }
+}
+
+HttpServer::ConnectionPtr HttpServer::acquire_connection(Acceptor& acceptor)
+{
+    auto& service = acceptor.pool.getService();
+    auto& shard = connection_pool_->current_shard();
+
+    ConnectionPtr connection = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.connections.empty())
         {
-            return;
+            connection = shard.connections.back();
+            shard.connections.pop_back();
         }
-        else
+    }
+
+    if (connection)
+    {
+        // The socket is bound to the io_context it has been created with.
+        if (std::addressof(connection->service()) == std::addressof(service))
         {
-            --connection_count_;
-            connections_.erase(it);
-            if (ev_hndl_)
-            {
-                ev_hndl_->connection_destroyed(connection);
-            }
+            connection->reuse(acceptor.ssl_ctx.get(), connection_pool_->max_buffer_size);
+            return connection;
         }
+
+        delete connection;
     }
 
-    if (release)
+    return new HTTP::Connection(*this, service, acceptor.ssl_ctx.get());
+}
+
+void HttpServer::release_connection(ConnectionPtr connection)
+{
+    connection->cancel();
+    connection->close();
+
+    auto& shard = connection_pool_->current_shard();
     {
-        HTTP::Connection::release(connection);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.connections.size() < connection_pool_->max_pooled)
+        {
+            shard.connections.push_back(connection);
+            return;
+        }
     }
+
+    delete connection;
 }
 
 void HttpServer::start_accept(AcceptorPtr acceptor)
 {
     if (running_)
     {
-        auto connection =
-            new HTTP::Connection(*this, pool_->getService(), acceptor->ssl_ctx.get());
+        auto connection = acquire_connection(*acceptor);
         mark(connection);
+        ++pending_accepts_;
 
+        std::lock_guard<std::mutex> lock(acceptor->mutex);
         acceptor->async_accept(
             connection->socket_,
             std::bind(&HttpServer::accept_callback, this, std::placeholders::_1, acceptor, connection)
         );
     }
+    else
+    {
+        // This accept slot will never be re-armed.
+        --running_acceptors_;
+    }
 }
 
 void HttpServer::accept_callback(
     const boost::system::error_code& error, AcceptorPtr acceptor, ConnectionPtr connection
 )
 {
+    --pending_accepts_;
     if (error)
     {
         destroy(connection);
@@ -280,28 +473,29 @@ void HttpServer::accept_callback(
         --running_acceptors_;
         return;
     }
+
+    // Re-arm before starting the connection to keep the accept depth during
+    // connection storms.
+    start_accept(acceptor);
+
+    if (running_)
+    {
+        LOG(server_logger, debug)
+            << "New connection accepted from: " << connection->source();
+        connection->start();
+    }
     else
     {
-        if (running_)
-        {
-            LOG(server_logger, debug)
-                << "New connection accepted from: " << connection->source();
-            connection->start();
-        }
-        else
-        {
-            destroy(connection);
-        }
+        destroy(connection);
     }
-
-    start_accept(acceptor);
 }
 
 HttpServer::AcceptorPtr HttpServer::bind(
-    boost::asio::io_service& service, const std::string& host, const std::string& port
+    ThreadPool& pool, const std::string& host, const std::string& port, bool reuse_port
 )
 {
-    auto acceptor = AcceptorPtr(new Acceptor(service));
+    auto acceptor = AcceptorPtr(new Acceptor(pool));
+    auto& service = pool.getService();
     boost::system::error_code error;
     auto addr = boost::asio::ip::address::from_string(host, error);
     boost::asio::ip::tcp::endpoint endpoint;
@@ -338,6 +532,22 @@ HttpServer::AcceptorPtr HttpServer::bind(
             << ", error msg: " << error.message();
     }
 
+#ifdef SO_REUSEPORT
+    if (reuse_port)
+    {
+        acceptor->set_option(ReusePort(true), error);
+        if (error)
+        {
+            LOG(server_logger, error)
+                << "Cannot set REUSEPORT on " << host << " on " << port
+                << ", error msg: " << error.message();
+            throw UTILS::convert_boost_ec_to_std_ec(error);
+        }
+    }
+#else
+    (void)reuse_port;
+#endif
+
     acceptor->bind(endpoint, error);
     if (error)
     {
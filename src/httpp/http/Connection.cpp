@@ -10,6 +10,7 @@
 
 #include "httpp/http/Connection.hpp"
 
+#include <cstring>
 #include <sstream>
 
 #include "httpp/HttpServer.hpp"
@@ -62,15 +63,56 @@ void Connection::releaseFromHandler(Connection* connection)
         throw std::logic_error("Invalid connection state");
     }
 
-    release(connection);
+    if (connection->defer_until_flushed(Held::Release))
+    {
+        return;
+    }
+
+    connection->disown();
+    connection->handler_.destroy(connection);
 }
 
-void Connection::release(Connection* connection)
+void Connection::reuse(boost::asio::ssl::context* ctx, size_t max_buffer_size)
 {
-    connection->cancel();
-    connection->close();
+    is_owned_ = false;
+    should_be_deleted_ = false;
+
+    if (request_buffer_.capacity() > max_buffer_size)
+    {
+        std::vector<char>().swap(request_buffer_);
+    }
+    request_buffer_.clear();
+    size_ = offset_body_start_ = offset_body_end_ = 0;
+    chunked_decoder_.reset();
+    if (output_buffer_.capacity() > max_buffer_size)
+    {
+        std::vector<char>().swap(output_buffer_);
+    }
+    clear_held();
+    held_ = Held::None;
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    request_start_ = 0;
+    parser_state_ = {};
+#endif
+
+    request_.clear();
+    response_.clear();
+    auto& body = response_.mutable_body();
+    if (body.capacity() > max_buffer_size)
+    {
+        std::vector<char>().swap(body);
+    }
 
-    delete connection;
+    // An SSL stream cannot be restarted once shut down.
+    need_handshake_ = true;
+    if (ctx)
+    {
+        ssl_socket_.reset(new SSLSocket(socket_, *ctx));
+    }
+    else
+    {
+        ssl_socket_.reset();
+    }
 }
 
 void Connection::cancel() noexcept
@@ -102,6 +144,8 @@ void Connection::markToBeDeleted()
         LOG(conn_logger_, debug) << "Connection marked to be deleted: " << this;
         cancel();
         close();
+        // Nothing is in flight while the response waits for its producer.
+        response_.abortStream();
     }
 }
 
@@ -147,11 +191,31 @@ void Connection::start()
     // request_buffer_
     if (!request_buffer_.empty())
     {
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+        // The previous request is released by moving the start index, what
+        // follows it is only moved once room is needed for a read.
+        request_start_ = offset_body_end_;
+        if (request_start_ == request_buffer_.size())
+        {
+            request_start_ = 0;
+            request_buffer_.clear();
+        }
+#else
         request_buffer_.erase(request_buffer_.begin(), request_buffer_.begin() + offset_body_end_);
+#endif
         size_ = request_buffer_.size();
     }
+    chunked_decoder_.reset();
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    parser_state_ = {};
+#endif
     request_.clear();
-    response_.clear();
+    {
+        // markToBeDeleted may be aborting the stream of the response.
+        std::lock_guard<std::mutex> lock(mutex_);
+        response_.clear();
+    }
+    response_.setDefaultHeaders(true, handler_.server_header_);
 
     if (ssl_socket_ && need_handshake_)
     {
@@ -185,10 +249,30 @@ void Connection::read_request()
         return;
     }
 
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+    // The parser resumes where the previous read left it, each byte is only
+    // looked at once whatever the number of reads the header took.
+    auto result = Parser::parse(
+        parser_state_, request_buffer_.data() + request_start_, size_ - request_start_, request_
+    );
+    if (result == Parser::Result::Complete)
+    {
+        request_.setDate();
+        DLOG(conn_logger_, trace) << "Received a request from: " << source() << ": " << request_;
+
+        offset_body_end_ = offset_body_start_ = request_start_ + parser_state_.offset;
+        dispatch_request();
+        return;
+    }
+    else if (result == Parser::Result::Error)
+    {
+        reject_request();
+        return;
+    }
+#elif HTTPP_PARSER_BACKEND_IS_STREAM
     if (Parser::isComplete(request_buffer_.data(), request_buffer_.size()))
     {
         request_.setDate();
-#if HTTPP_PARSER_BACKEND_IS_STREAM
         UTILS::VectorStreamBuf buf(request_buffer_, size_);
         std::istream is(std::addressof(buf));
         if (Parser::parse(is, request_))
@@ -199,76 +283,87 @@ void Connection::read_request()
             buf.shrinkVector();
             body_buffer_.swap(request_buffer_);
 
-            disown();
-            handler_.connection_notify_request(this);
+            dispatch_request();
         }
-#elif HTTPP_PARSER_BACKEND_IS_RAGEL
-        const char* begin = request_buffer_.data();
-        const char* end = begin + size_;
-        size_t consumed = 0;
-        if (Parser::parse(begin, end, consumed, request_))
-        {
-            DLOG(conn_logger_, trace)
-                << "Received a request from: " << source() << ": " << request_;
-
-            offset_body_end_ = offset_body_start_ = consumed;
-            disown();
-            handler_.connection_notify_request(this);
-        }
-#endif
         else
         {
-            LOG(conn_logger_, warning)
-                << "Invalid request received from: " << source() << "\n"
-                << std::string(request_buffer_.data(), size_);
-
-            response_.setCode(HttpCode::BadRequest)
-                .setBody(
-                    "An error occured in the request parsing indicating an "
-                    "error"
-                )
-                .connectionShouldBeClosed(true);
-            disown();
-            sendResponse();
+            reject_request();
         }
+        return;
     }
-    else
+#endif
+
+    if (request_buffer_.capacity() - size_ < BUF_SIZE)
     {
-        request_buffer_.resize(request_buffer_.capacity());
-        if (size_ == request_buffer_.size())
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+        // Move what has been received of this request over the ones already
+        // handled, the parser state is relative to the request start.
+        if (request_start_)
         {
-            request_buffer_.resize(request_buffer_.size() + BUF_SIZE);
+            char* begin = request_buffer_.data();
+            request_.relocate(begin + request_start_, begin + size_, begin);
+            std::memmove(begin, begin + request_start_, size_ - request_start_);
+            size_ -= request_start_;
+            request_start_ = 0;
+            request_buffer_.resize(size_);
         }
 
-        char* data = request_buffer_.data();
-        data += size_;
+        if (request_buffer_.capacity() - size_ < BUF_SIZE)
+#endif
+        {
+            grow_request_buffer(size_ + BUF_SIZE);
+        }
+    }
+    request_buffer_.resize(request_buffer_.capacity());
 
-        async_read_some(
-            boost::asio::buffer(data, BUF_SIZE),
-            [this](const boost::system::error_code& ec, size_t size)
-            {
-                if (ec)
-                {
-                    disown();
-                    handler_.connection_error(this, ec);
-                    return;
-                }
+    char* data = request_buffer_.data();
+    data += size_;
 
-                size_ += size;
-                request_buffer_.resize(size_);
-                read_request();
+    async_read_some(
+        boost::asio::buffer(data, BUF_SIZE),
+        [this](const boost::system::error_code& ec, size_t size)
+        {
+            if (ec)
+            {
+                disown();
+                handler_.connection_error(this, ec);
+                return;
             }
-        );
-    }
+
+            size_ += size;
+            request_buffer_.resize(size_);
+            read_request();
+        }
+    );
 }
 
-void Connection::reparse()
+void Connection::reject_request()
 {
-    request_.clear();
+    LOG(conn_logger_, warning) << "Invalid request received from: " << source() << "\n"
+                               << std::string(request_buffer_.data(), size_);
+
+    response_.setCode(HttpCode::BadRequest)
+        .setBody(
+            "An error occured in the request parsing indicating an "
+            "error"
+        )
+        .connectionShouldBeClosed(true);
+    disown();
+    sendResponse();
+}
+
+void Connection::grow_request_buffer(size_t capacity)
+{
+    std::vector<char> buffer;
+    buffer.reserve(capacity);
+    buffer.assign(request_buffer_.begin(), request_buffer_.end());
+
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
     const char* begin = request_buffer_.data();
-    const char* end = begin + offset_body_start_;
-    size_t consumed = 0;
-    Parser::parse(begin, end, consumed, request_);
+    request_.relocate(begin, begin + request_buffer_.size(), buffer.data());
+#endif
+
+    request_buffer_.swap(buffer);
 }
 
 void Connection::sendResponse(Callback&& cb)
@@ -288,6 +383,7 @@ void Connection::sendResponse(Callback&& cb)
     auto handler = [cb, this](const boost::system::error_code& ec, size_t)
     {
         disown();
+        clear_held();
         if (ec)
         {
             handler_.connection_error(this, ec);
@@ -299,11 +395,11 @@ void Connection::sendResponse(Callback&& cb)
     std::unique_lock<std::mutex> lock(mutex_);
     if (ssl_socket_)
     {
-        response_.sendResponse(*ssl_socket_, std::move(handler));
+        response_.sendResponse(*ssl_socket_, std::move(handler), held_buffers());
     }
     else
     {
-        response_.sendResponse(socket_, std::move(handler));
+        response_.sendResponse(socket_, std::move(handler), held_buffers());
     }
 }
 
@@ -321,6 +417,171 @@ void Connection::sendResponse()
         throw std::logic_error("Invalid connection state");
     }
 
+    if (!defer_until_flushed(Held::Send))
+    {
+        send_response();
+    }
+}
+
+void Connection::dispatch_request()
+{
+    disown();
+    if (output_buffer_.empty())
+    {
+        handler_.connection_notify_request(this);
+        return;
+    }
+
+    // Until the handler returns, nothing else runs on this connection: a
+    // response it sends is only written after.
+    held_ = Held::Dispatching;
+    handler_.connection_notify_request(this);
+
+    auto state = Held::Dispatching;
+    if (held_.compare_exchange_strong(state, Held::Flushing))
+    {
+        // It answers later, the client should not wait for it to get the
+        // previous responses.
+        flush_held();
+        return;
+    }
+
+    if (state == Held::Release)
+    {
+        // The held responses are still due, it is released once they are
+        // written.
+        flush_held();
+        return;
+    }
+
+    // They go out with this response.
+    held_ = Held::None;
+    send_response();
+}
+
+const std::vector<boost::asio::const_buffer>& Connection::held_buffers()
+{
+    // output_buffer_ does not grow anymore until they are written.
+    output_buffers_.clear();
+    size_t offset = 0;
+    for (const auto& queued : output_segments_)
+    {
+        if (queued.offset > offset)
+        {
+            output_buffers_.emplace_back(output_buffer_.data() + offset, queued.offset - offset);
+        }
+        output_buffers_.push_back(queued.segment.data);
+        offset = queued.offset;
+    }
+
+    if (output_buffer_.size() > offset)
+    {
+        output_buffers_.emplace_back(output_buffer_.data() + offset, output_buffer_.size() - offset);
+    }
+    return output_buffers_;
+}
+
+void Connection::clear_held() noexcept
+{
+    output_buffer_.clear();
+    output_segments_.clear();
+    output_buffers_.clear();
+}
+
+void Connection::flush_held()
+{
+    auto handler = [this](const boost::system::error_code& ec, size_t)
+    {
+        // A failure is seen again by the write of the next response.
+        if (ec)
+        {
+            LOG(conn_logger_, debug) << "Cannot write the held responses: " << ec.message();
+        }
+
+        clear_held();
+        auto state = held_.exchange(Held::None);
+        if (state != Held::Flushing)
+        {
+            resume(state);
+        }
+    };
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (ssl_socket_)
+    {
+        boost::asio::async_write(*ssl_socket_, held_buffers(), handler);
+    }
+    else
+    {
+        boost::asio::async_write(socket_, held_buffers(), handler);
+    }
+}
+
+bool Connection::defer_until_flushed(Held action) noexcept
+{
+    auto state = held_.load();
+    while (state == Held::Dispatching || state == Held::Flushing)
+    {
+        if (held_.compare_exchange_weak(state, action))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Connection::resume(Held action)
+{
+    if (action == Held::Send)
+    {
+        send_response();
+    }
+    else
+    {
+        disown();
+        handler_.destroy(this);
+    }
+}
+
+void Connection::send_response()
+{
+    if (is_not_modified())
+    {
+        response_.setNotModified();
+    }
+
+    if (handler_.compression_)
+    {
+        auto coding = helper::negotiate_coding(request_.header(HeaderId::AcceptEncoding));
+        response_.setContentCoding(coding, *handler_.compression_);
+    }
+
+    // The client did not wait for this response to send the next request,
+    // it is queued so that the responses to the whole batch go out in one
+    // write. Its head and copied body are, its shared segments are written
+    // from where they are: large copied bodies are not queued.
+    if (!shouldBeDeleted() && response_.isComplete() && !response_.isChunked()
+        && !response_.hasBodyFile() && !response_.connectionShouldBeClosed() && output_buffer_.size() < PIPELINE_FLUSH_SIZE
+        && response_.body().size() < PIPELINE_FLUSH_SIZE && has_pipelined_request())
+    {
+        if (handler_.ev_hndl_)
+        {
+            handler_.ev_hndl_->response_send(this);
+        }
+
+        response_.serialize(output_buffer_, output_segments_);
+        disown();
+        boost::asio::post(
+            service(),
+            [this]
+            {
+                recycle();
+            }
+        );
+        return;
+    }
+
     sendResponse(
         [this]
         {
@@ -329,6 +590,33 @@ void Connection::sendResponse()
     );
 }
 
+bool Connection::sendIfNotModified()
+{
+    if (!is_not_modified())
+    {
+        return false;
+    }
+
+    sendResponse();
+    return true;
+}
+
+bool Connection::is_not_modified() const noexcept
+{
+    return (request_.method == Method::GET || request_.method == Method::HEAD)
+           && response_.getCode() == HttpCode::Ok
+           && response_.isNotModified(
+               request_.header(HeaderId::IfNoneMatch), request_.header(HeaderId::IfModifiedSince)
+           );
+}
+
+bool Connection::has_pipelined_request() const noexcept
+{
+    auto size = request_buffer_.size();
+    return offset_body_end_ < size
+           && Parser::isComplete(request_buffer_.data() + offset_body_end_, size - offset_body_end_);
+}
+
 void Connection::sendContinue(Callback&& cb)
 {
     if (!own())
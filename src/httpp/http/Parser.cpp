@@ -10,11 +10,18 @@
 
 #include "httpp/http/Parser.hpp"
 
+#include <cstdint>
 #include <cstring>
 #include <functional>
 #include <istream>
 #include <iterator>
 
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#elif defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
 #include <commonpp/core/LoggingInterface.hpp>
 
 #include "httpp/http/Request.hpp"
@@ -99,6 +106,14 @@ static bool parse_method(Iterator& it, Request& request)
                 return true;
             }
         }
+        else if (*it == 'A')
+        {
+            if (expect(it, "ATCH"))
+            {
+                request.method = Method::PATCH;
+                return true;
+            }
+        }
         break;
     case 'D':
         if (expect(it, "DELETE"))
@@ -255,7 +270,8 @@ static bool parse_headers(Iterator& it, Request& request)
 
         if (res)
         {
-            request.headers.emplace_back(std::move(key), std::move(value));
+            request.addHeader(key);
+            res = request.setHeaderValue(value);
         }
 
         res = res && expect(it, HTTP_DELIMITER);
@@ -282,15 +298,92 @@ bool Parser::parse(std::istream& is, Request& request)
 
 bool Parser::isComplete(const char* buffer, size_t n)
 {
-    if (n < 4)
+    return findHeaderEnd(buffer, n) != 0;
+}
+
+static inline bool is_header_end(const char* p)
+{
+    return p[0] == '\r' && p[1] == '\n' && p[2] == '\r' && p[3] == '\n';
+}
+
+// The vectorized loops compare 'block' positions at once: a position is a
+// candidate if it holds a '\r' and the byte 3 positions later a '\n', only
+// candidates are fully checked.
+#if defined(__AVX2__)
+static const char* find_header_end_simd(const char* p, const char* end)
+{
+    const auto cr = _mm256_set1_epi8('\r');
+    const auto lf = _mm256_set1_epi8('\n');
+    for (; p + 32 + 3 <= end; p += 32)
+    {
+        auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        auto last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 3));
+        uint32_t mask = _mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, cr), _mm256_cmpeq_epi8(last, lf))
+        );
+        while (mask)
+        {
+            auto candidate = p + __builtin_ctz(mask);
+            if (is_header_end(candidate))
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return p;
+}
+#elif defined(__SSE2__)
+static const char* find_header_end_simd(const char* p, const char* end)
+{
+    const auto cr = _mm_set1_epi8('\r');
+    const auto lf = _mm_set1_epi8('\n');
+    for (; p + 16 + 3 <= end; p += 16)
+    {
+        auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3));
+        uint32_t mask = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, cr), _mm_cmpeq_epi8(last, lf))
+        );
+        while (mask)
+        {
+            auto candidate = p + __builtin_ctz(mask);
+            if (is_header_end(candidate))
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return p;
+}
+#else
+static const char* find_header_end_simd(const char* p, const char*)
+{
+    return p;
+}
+#endif
+
+size_t Parser::findHeaderEnd(const char* buffer, size_t n, size_t from)
+{
+    if (n < 4 || from > n - 4)
     {
-        return false;
+        return 0;
     }
 
-    static const char MARKER[] = {'\r', '\n', '\r', '\n'};
+    const char* end = buffer + n;
+    const char* p = find_header_end_simd(buffer + from, end);
+
+    // Either the SIMD loop found it or there are less than a block left.
+    for (; p + 4 <= end; ++p)
+    {
+        if (is_header_end(p))
+        {
+            return p + 4 - buffer;
+        }
+    }
 
-    auto buffer_end = buffer + n;
-    return std::search(buffer, buffer_end, std::begin(MARKER), std::end(MARKER)) != buffer_end;
+    return 0;
 }
 
 } // namespace HTTP
@@ -42,6 +42,8 @@ std::string_view to_string(Method method)
         return "OPTIONS"sv;
     case Method::DELETE_:
         return "DELETE"sv;
+    case Method::PATCH:
+        return "PATCH"sv;
     }
 }
 
@@ -53,7 +55,8 @@ std::string_view to_string(Method method)
     FN(DELETE, DELETE_)                                                        \
     FN(OPTIONS, OPTIONS)                                                       \
     FN(TRACE, TRACE)                                                           \
-    FN(CONNECT, CONNECT)
+    FN(CONNECT, CONNECT)                                                       \
+    FN(PATCH, PATCH)
 
 Method method_from(std::string_view str)
 {
@@ -126,5 +129,227 @@ std::string_view getDefaultMessage(HttpCode code)
     }
 }
 
+struct StatusLine
+{
+    char data[64] = {};
+    size_t size = 0;
+};
+
+static constexpr StatusLine make_status_line(unsigned code, std::string_view message) noexcept
+{
+    StatusLine line;
+    auto append = [&line](std::string_view str)
+    {
+        for (char c : str)
+        {
+            line.data[line.size++] = c;
+        }
+    };
+
+    append("HTTP/1.1 "sv);
+    line.data[line.size++] = char('0' + code / 100);
+    line.data[line.size++] = char('0' + code / 10 % 10);
+    line.data[line.size++] = char('0' + code % 10);
+    line.data[line.size++] = ' ';
+    append(message);
+    append("\r\n"sv);
+    return line;
+}
+
+std::string_view status_line(HttpCode code)
+{
+    switch (code)
+    {
+    default:
+        return {};
+
+#define FN(code)                                                               \
+    case HttpCode::code:                                                       \
+    {                                                                          \
+        static constexpr auto line =                                           \
+            make_status_line(unsigned(HttpCode::code), #code##sv);             \
+        return {line.data, line.size};                                         \
+    }
+        APPLY_ON_HTTP_CODE(FN)
+#undef FN
+    }
+}
+
+void format_http_date(std::time_t time, char (&out)[HTTP_DATE_SIZE]) noexcept
+{
+    // Not strftime, the names must not depend on the locale.
+    static const char DAYS[][4] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char MONTHS[][4] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    };
+
+    std::tm tm;
+    ::gmtime_r(&time, &tm);
+
+    auto two_digits = [](char* p, int value)
+    {
+        p[0] = char('0' + value / 10 % 10);
+        p[1] = char('0' + value % 10);
+    };
+
+    std::memcpy(out, "Www, 00 Mmm 0000 00:00:00 GMT", HTTP_DATE_SIZE);
+    std::memcpy(out, DAYS[tm.tm_wday], 3);
+    two_digits(out + 5, tm.tm_mday);
+    std::memcpy(out + 8, MONTHS[tm.tm_mon], 3);
+    auto year = tm.tm_year + 1900;
+    two_digits(out + 12, year / 100);
+    two_digits(out + 14, year);
+    two_digits(out + 17, tm.tm_hour);
+    two_digits(out + 20, tm.tm_min);
+    two_digits(out + 23, tm.tm_sec);
+}
+
+bool parse_http_date(std::string_view str, std::time_t& time) noexcept
+{
+    static const std::string_view MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec"sv;
+
+    if (str.size() != HTTP_DATE_SIZE || str.substr(3, 2) != ", "sv || str[7] != ' '
+        || str[11] != ' ' || str[16] != ' ' || str[19] != ':' || str[22] != ':'
+        || str.substr(25) != " GMT"sv)
+    {
+        return false;
+    }
+
+    bool valid = true;
+    auto number = [&str, &valid](size_t pos, size_t size)
+    {
+        int value = 0;
+        for (auto c : str.substr(pos, size))
+        {
+            valid = valid && c >= '0' && c <= '9';
+            value = value * 10 + (c - '0');
+        }
+        return value;
+    };
+
+    auto month = MONTHS.find(str.substr(8, 3));
+    std::tm tm = {};
+    tm.tm_mday = number(5, 2);
+    tm.tm_year = number(12, 4) - 1900;
+    tm.tm_hour = number(17, 2);
+    tm.tm_min = number(20, 2);
+    tm.tm_sec = number(23, 2);
+    if (!valid || month == std::string_view::npos || month % 3 || tm.tm_mday < 1
+        || tm.tm_mday > 31 || tm.tm_hour > 23 || tm.tm_min > 59 || tm.tm_sec > 60)
+    {
+        return false;
+    }
+
+    tm.tm_mon = int(month / 3);
+    time = ::timegm(&tm);
+    return true;
+}
+
+std::string_view date_header()
+{
+    static constexpr auto PREFIX = "Date: "sv;
+
+    struct Cache
+    {
+        std::time_t second = -1;
+        char line[PREFIX.size() + HTTP_DATE_SIZE + 2];
+    };
+
+    static thread_local Cache cache;
+
+    auto now = std::time(nullptr);
+    if (now != cache.second)
+    {
+        char date[HTTP_DATE_SIZE];
+        format_http_date(now, date);
+        std::memcpy(cache.line, PREFIX.data(), PREFIX.size());
+        std::memcpy(cache.line + PREFIX.size(), date, HTTP_DATE_SIZE);
+        std::memcpy(cache.line + PREFIX.size() + HTTP_DATE_SIZE, "\r\n", 2);
+        cache.second = now;
+    }
+
+    return {cache.line, sizeof(cache.line)};
+}
+
+static constexpr std::string_view HEADER_NAMES[] = {
+#define fn(e, name) name##sv,
+    HTTPP_APPLY_ON_HEADER(fn)
+#undef fn
+};
+
+static_assert(sizeof(HEADER_NAMES) / sizeof(HEADER_NAMES[0]) == NB_HEADER_IDS);
+
+// Mix the length and a few characters of the lowercase name, the constants
+// are chosen so that every standard name gets its own slot.
+static constexpr uint32_t header_slot(std::string_view name) noexcept
+{
+    auto at = [name](size_t i) -> uint32_t { return uint8_t(name[i]) | 0x20; };
+
+    auto n = name.size();
+    uint32_t key =
+        uint32_t(n * 0x1000193) ^ (at(0) | at(n - 1) << 8 | at(n / 2) << 16 | at(n - 2) << 24);
+    return (key * 0xb55351ebu) >> 24;
+}
+
+struct HeaderTable
+{
+    uint8_t slots[256] = {};
+    bool perfect = true;
+};
+
+static constexpr HeaderTable make_header_table() noexcept
+{
+    HeaderTable table;
+    for (auto& slot : table.slots)
+    {
+        slot = uint8_t(HeaderId::Unknown);
+    }
+
+    for (size_t i = 0; i < NB_HEADER_IDS; ++i)
+    {
+        auto& slot = table.slots[header_slot(HEADER_NAMES[i])];
+        table.perfect = table.perfect && slot == uint8_t(HeaderId::Unknown);
+        slot = uint8_t(i);
+    }
+
+    return table;
+}
+
+static constexpr HeaderTable HEADER_TABLE = make_header_table();
+static_assert(HEADER_TABLE.perfect, "Two header names share a slot, the hash needs new constants");
+
+std::string_view to_string(HeaderId id)
+{
+    if (id == HeaderId::Unknown)
+    {
+        return "Unknown"sv;
+    }
+
+    return HEADER_NAMES[size_t(id)];
+}
+
+HeaderId header_id_from(std::string_view name) noexcept
+{
+    if (name.size() < 2)
+    {
+        return HeaderId::Unknown;
+    }
+
+    auto id = HeaderId(HEADER_TABLE.slots[header_slot(name)]);
+    if (id == HeaderId::Unknown)
+    {
+        return id;
+    }
+
+    const auto& candidate = HEADER_NAMES[size_t(id)];
+    if (candidate.size() != name.size()
+        || ::strncasecmp(candidate.data(), name.data(), name.size()) != 0)
+    {
+        return HeaderId::Unknown;
+    }
+
+    return id;
+}
+
 } // namespace HTTP
 } // namespace HTTPP
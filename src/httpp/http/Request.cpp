@@ -10,6 +10,10 @@
 
 #include "httpp/http/Request.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <ostream>
 
 #include <commonpp/core/string/std_tostring.hpp>
@@ -21,14 +25,22 @@ namespace HTTP
 {
 std::ostream& operator<<(std::ostream& os, const Request& request)
 {
-    os << to_string(request.method) << " ";
+    if (request.method == Method::EXTENSION)
+    {
+        os << request.method_name << " ";
+    }
+    else
+    {
+        os << to_string(request.method) << " ";
+    }
+
     std::string uri = commonpp::string::stringify(request.uri);
     if (!request.query_params.empty())
     {
         uri += '?';
         for (const auto& q : request.query_params)
         {
-            uri += q.first + "=" + to_string(q.second) + "&";
+            uri += to_string(q.first) + "=" + to_string(q.second) + "&";
         }
     }
 
@@ -48,11 +60,303 @@ void Request::setDate()
 
 void Request::clear()
 {
+    method_name = {};
     uri = "";
     headers.clear();
+    header_ids.clear();
+    header_index_ = {};
     query_params.clear();
+    query_index_.clear();
+    query_indexed_ = 0;
     major = minor = 0;
+    has_content_length = false;
+    content_length = 0;
+    chunked = false;
+    connection = ConnectionOption::Default;
+    host = {};
+}
+
+static inline bool is_iequal(std::string_view s1, std::string_view s2)
+{
+    return s1.size() == s2.size() && ::strncasecmp(s1.data(), s2.data(), s1.size()) == 0;
+}
+
+static std::string_view trim(std::string_view str)
+{
+    static const char WS[] = " \t";
+    auto begin = str.find_first_not_of(WS);
+    if (begin == std::string_view::npos)
+    {
+        return {};
+    }
+
+    return str.substr(begin, str.find_last_not_of(WS) - begin + 1);
+}
+
+static bool parse_content_length(std::string_view str, size_t& length)
+{
+    if (str.empty())
+    {
+        return false;
+    }
+
+    size_t value = 0;
+    for (char c : str)
+    {
+        if (c < '0' || c > '9')
+        {
+            return false;
+        }
+
+        size_t digit = c - '0';
+        if (value > (std::numeric_limits<size_t>::max() - digit) / 10)
+        {
+            return false;
+        }
+
+        value = value * 10 + digit;
+    }
+
+    length = value;
+    return true;
+}
+
+void Request::addHeader(std::string_view key)
+{
+    auto id = header_id_from(key);
+    headers.emplace_back(key, "");
+    header_ids.push_back(id);
+
+    if (id != HeaderId::Unknown && !header_index_[size_t(id)]
+        && headers.size() <= std::numeric_limits<uint16_t>::max())
+    {
+        header_index_[size_t(id)] = uint16_t(headers.size());
+    }
+}
+
+void Request::close_if_ambiguous() noexcept
+{
+    // Framed by the chunked coding, but an intermediary may have used the
+    // length: what follows cannot be trusted (RFC 9112 section 6.3).
+    if (chunked && has_content_length)
+    {
+        connection = ConnectionOption::Close;
+    }
+}
+
+bool Request::setHeaderValue(std::string_view value)
+{
+    headers.back().second = value;
+
+    switch (header_ids.back())
+    {
+    case HeaderId::Host:
+        host = trim(value);
+        break;
+    case HeaderId::Connection:
+        // A list of options, over every Connection header: close wins.
+        while (!value.empty())
+        {
+            auto comma = value.find(',');
+            auto option = trim(value.substr(0, comma));
+            value.remove_prefix(comma == std::string_view::npos ? value.size() : comma + 1);
+            if (is_iequal(option, "Close"))
+            {
+                connection = ConnectionOption::Close;
+            }
+            else if (is_iequal(option, "Keep-Alive") && connection == ConnectionOption::Default)
+            {
+                connection = ConnectionOption::KeepAlive;
+            }
+        }
+        break;
+    case HeaderId::ContentLength:
+    {
+        size_t length = 0;
+        if (!parse_content_length(trim(value), length))
+        {
+            return false;
+        }
+
+        // Repeated values have to agree, otherwise the framing is
+        // ambiguous.
+        if (has_content_length && length != content_length)
+        {
+            return false;
+        }
+
+        has_content_length = true;
+        content_length = length;
+        close_if_ambiguous();
+        break;
+    }
+    case HeaderId::TransferEncoding:
+    {
+        // Chunked has to be the last coding applied.
+        value = trim(value);
+        auto last = value.rfind(',');
+        if (last != std::string_view::npos)
+        {
+            value = trim(value.substr(last + 1));
+        }
+        chunked = is_iequal(value, "chunked");
+        close_if_ambiguous();
+        break;
+    }
+    default:
+        break;
+    }
+
+    return true;
+}
+
+std::string_view Request::header(HeaderId id) const noexcept
+{
+    if (id == HeaderId::Unknown || !header_index_[size_t(id)])
+    {
+        return {};
+    }
+
+    return headers[header_index_[size_t(id)] - 1].second;
+}
+
+std::string_view Request::header(std::string_view name) const noexcept
+{
+    auto id = header_id_from(name);
+    if (id != HeaderId::Unknown)
+    {
+        return header(id);
+    }
+
+    for (const auto& h : headers)
+    {
+        if (is_iequal(h.first, name))
+        {
+            return h.second;
+        }
+    }
+
+    return {};
+}
+
+static inline std::string_view key_view(const std::string& key)
+{
+    return key;
+}
+
+static inline std::string_view key_view(const UTILS::LazyDecodedValue& key)
+{
+    return key.view();
+}
+
+void Request::indexQueryParams() const
+{
+    auto n = std::min<size_t>(query_params.size(), std::numeric_limits<uint16_t>::max());
+
+    // At most half full
+    size_t size = 8;
+    while (size < n * 2)
+    {
+        size *= 2;
+    }
+
+    query_index_.assign(size, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto key = key_view(query_params[i].first);
+        auto slot = std::hash<std::string_view>()(key) & (size - 1);
+        // The first parameter with a name wins.
+        while (query_index_[slot] && key_view(query_params[query_index_[slot] - 1].first) != key)
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+
+        if (!query_index_[slot])
+        {
+            query_index_[slot] = uint16_t(i + 1);
+        }
+    }
+
+    query_indexed_ = query_params.size();
+}
+
+const Request::QueryParamRef* Request::findQueryParam(std::string_view key) const
+{
+    if (query_params.empty())
+    {
+        return nullptr;
+    }
+
+    if (query_index_.empty() || query_indexed_ != query_params.size())
+    {
+        indexQueryParams();
+    }
+
+    auto mask = query_index_.size() - 1;
+    for (auto slot = std::hash<std::string_view>()(key) & mask; query_index_[slot]; slot = (slot + 1) & mask)
+    {
+        const auto& param = query_params[query_index_[slot] - 1];
+        if (key_view(param.first) == key)
+        {
+            return &param;
+        }
+    }
+
+    return nullptr;
+}
+
+const Request::QueryParamRef::second_type& Request::queryParam(std::string_view key) const
+{
+    static const QueryParamRef::second_type not_found{};
+    auto param = findQueryParam(key);
+    return param ? param->second : not_found;
+}
+
+bool Request::keepAlive() const noexcept
+{
+    switch (connection)
+    {
+    case ConnectionOption::Close:
+        return false;
+    case ConnectionOption::KeepAlive:
+        return true;
+    default:
+        return major == 1 && minor == 1;
+    }
+}
+
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+void Request::relocate(const char* begin, const char* end, const char* to)
+{
+    // Views that do not point into the buffer (string literals for the
+    // missing values) are left as they are.
+    auto move = [begin, end, to](std::string_view view)
+    {
+        std::less_equal<const char*> le;
+        if (le(begin, view.data()) && le(view.data() + view.size(), end))
+        {
+            return std::string_view(to + (view.data() - begin), view.size());
+        }
+        return view;
+    };
+
+    method_name = move(method_name);
+    uri = move(uri);
+    host = move(host);
+
+    for (auto& header : headers)
+    {
+        header.first = move(header.first);
+        header.second = move(header.second);
+    }
+
+    for (auto& param : query_params)
+    {
+        param.first = UTILS::LazyDecodedValue(move(param.first.raw()));
+        param.second = UTILS::LazyDecodedValue(move(param.second.raw()));
+    }
 }
+#endif
 
 } // namespace HTTP
 } // namespace HTTPP
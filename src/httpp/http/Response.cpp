@@ -10,27 +10,23 @@
 
 #include "httpp/http/Response.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
 #include <cstring>
 #include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace HTTPP
 {
 namespace HTTP
 {
-const char Response::HTTP_START[] = {
-    'H',
-    'T',
-    'T',
-    'P',
-    '/',
-    '1',
-    '.',
-    '1',
-    ' ',
-};
-const char Response::SPACE[] = {
-    ' ',
-};
 const char Response::HTTP_DELIMITER[] = {
     '\r',
     '\n',
@@ -47,6 +43,24 @@ const char Response::END_OF_STREAM_MARKER[] = {
     '\n',
 };
 
+struct Response::BodyFile
+{
+    explicit BodyFile(int fd)
+    : fd(fd)
+    {
+    }
+
+    ~BodyFile()
+    {
+        ::close(fd);
+    }
+
+    int fd;
+};
+
+// Size of the reads when the file cannot be sent with sendfile(2)
+static constexpr size_t FILE_CHUNK_SIZE = 64 * 1024;
+
 Response::Response(HttpCode code)
 {
     setCode(code);
@@ -65,17 +79,34 @@ Response::Response(HttpCode code, ChunkedResponseCallback&& callback)
     setCode(code);
 }
 
+Response::~Response()
+{
+    release_stream();
+}
+
 void Response::clear()
 {
+    release_stream();
     setCode(HttpCode::Ok);
     setBody("");
 
     should_be_closed_ = false;
     chunkedBodyCallback_ = nullptr;
-    current_chunk_ = "";
-    current_chunk_header_[0] = 0;
+    chunk_stream_.reset();
+    stream_chunks_.clear();
+    segments_.clear();
+    file_.reset();
+    max_chunk_bytes_ = DEFAULT_MAX_CHUNK_BYTES;
+    max_chunk_delay_ = {};
+    coding_ = helper::ContentCoding::Identity;
+    compression_enabled_ = false;
+    compress_ = true;
+    helper::Deflater::release(std::move(deflater_));
     status_string_.clear();
     headers_.clear();
+    etag_.clear();
+    last_modified_ = -1;
+    not_modified_size_ = 0;
 }
 
 Response& Response::addHeader(std::string k, std::string v)
@@ -103,19 +134,621 @@ Response& Response::addHeader(std::string k, std::string v)
     return *this;
 }
 
+Response& Response::setETag(std::string_view tag, bool weak)
+{
+    if (tag.find('"') != std::string_view::npos)
+    {
+        throw std::invalid_argument("An entity tag cannot contain a double quote");
+    }
+
+    etag_.clear();
+    if (weak)
+    {
+        etag_ = "W/";
+    }
+    etag_ += '"';
+    etag_.append(tag);
+    etag_ += '"';
+    return *this;
+}
+
+// The tag without its weakness, for the weak comparison of RFC 7232.
+static std::string_view opaque_tag(std::string_view etag) noexcept
+{
+    if (etag.substr(0, 2) == "W/")
+    {
+        etag.remove_prefix(2);
+    }
+    return etag;
+}
+
+// Whether tag is own with the suffix of a content coding, the tag of a
+// compressed variant of the same representation.
+static bool is_coded_tag(std::string_view tag, std::string_view own) noexcept
+{
+    auto open = own.size() - 1;
+    if (tag.size() <= own.size() + 1 || tag.back() != '"' || tag.substr(0, open) != own.substr(0, open)
+        || tag[open] != '-')
+    {
+        return false;
+    }
+
+    auto coding = tag.substr(own.size(), tag.size() - own.size() - 1);
+    for (size_t i = 1; i < helper::NB_CONTENT_CODINGS; ++i)
+    {
+        if (coding == helper::to_string(helper::ContentCoding(i)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Response::isNotModified(std::string_view if_none_match, std::string_view if_modified_since) const noexcept
+{
+    if (!if_none_match.empty())
+    {
+        if (etag_.empty())
+        {
+            return false;
+        }
+
+        // A list of quoted tags, that may contain commas, or "*".
+        auto own = opaque_tag(etag_);
+        size_t i = 0;
+        while (i < if_none_match.size())
+        {
+            auto c = if_none_match[i];
+            if (c == ' ' || c == '\t' || c == ',')
+            {
+                ++i;
+                continue;
+            }
+
+            if (c == '*')
+            {
+                return true;
+            }
+
+            auto begin = i;
+            if (if_none_match.substr(i, 2) == "W/")
+            {
+                i += 2;
+            }
+
+            if (i >= if_none_match.size() || if_none_match[i] != '"')
+            {
+                return false;
+            }
+
+            auto end = if_none_match.find('"', i + 1);
+            if (end == std::string_view::npos)
+            {
+                return false;
+            }
+
+            i = end + 1;
+            auto tag = opaque_tag(if_none_match.substr(begin, i - begin));
+            if (tag == own || is_coded_tag(tag, own))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::time_t since;
+    return last_modified_ != -1 && !if_modified_since.empty()
+           && parse_http_date(if_modified_since, since) && last_modified_ <= since;
+}
+
+Response& Response::setNotModified()
+{
+    if (chunk_stream_)
+    {
+        // Its producer has nothing left to push.
+        chunk_stream_->fail(boost::asio::error::operation_aborted);
+    }
+
+    // Its headers are those of the full response, which only varies on
+    // Accept-Encoding with a body that could be compressed.
+    not_modified_size_ = file_ ? 0 : is_chunked_enconding() ? SIZE_MAX : bodySize();
+    setCode(HttpCode::NotModified);
+    setBody(std::string_view());
+    chunkedBodyCallback_ = nullptr;
+    chunk_stream_.reset();
+    segments_.clear();
+    file_.reset();
+    return *this;
+}
+
 Response& Response::setBody(std::string_view body)
 {
     chunkedBodyCallback_ = nullptr;
+    chunk_stream_.reset();
+    segments_.clear();
+    file_.reset();
     body_.reserve(body.size());
     body_.assign(std::begin(body), std::end(body));
     return *this;
 }
 
+Response& Response::setBody(std::string&& body)
+{
+    return setBody(std::make_shared<const std::string>(std::move(body)));
+}
+
+Response& Response::setBody(std::vector<char>&& body)
+{
+    chunkedBodyCallback_ = nullptr;
+    chunk_stream_.reset();
+    segments_.clear();
+    file_.reset();
+    body_ = std::move(body);
+    return *this;
+}
+
+Response& Response::setBody(std::shared_ptr<const std::string> body)
+{
+    if (!body)
+    {
+        throw std::invalid_argument("Setting a null response body");
+    }
+
+    setBody(std::string_view());
+    auto data = boost::asio::buffer(*body);
+    segments_.push_back({data, std::move(body)});
+    return *this;
+}
+
+Response& Response::appendBody(BodySegment segment)
+{
+    chunkedBodyCallback_ = nullptr;
+    chunk_stream_.reset();
+    file_.reset();
+    if (segment.data.size())
+    {
+        segments_.push_back(std::move(segment));
+    }
+    return *this;
+}
+
+size_t Response::bodySize() const noexcept
+{
+    size_t size = body_.size();
+    for (const auto& segment : segments_)
+    {
+        size += segment.data.size();
+    }
+
+    if (file_)
+    {
+        size += file_end_ - file_begin_;
+    }
+    return size;
+}
+
+Response& Response::setBodyFile(int fd, uint64_t offset, uint64_t length)
+{
+    auto file = std::make_shared<BodyFile>(fd);
+    setBody(std::string_view());
+    file_ = std::move(file);
+    file_begin_ = file_offset_ = offset;
+    file_end_ = offset + length;
+    return *this;
+}
+
+namespace
+{
+enum class Range
+{
+    Ignored,
+    Satisfiable,
+    NotSatisfiable,
+};
+} // namespace
+
+// A single "bytes=first-last", "bytes=first-" or "bytes=-suffix" range of
+// RFC 7233, clamped to size.
+static Range parse_range(std::string_view range, uint64_t size, uint64_t& first, uint64_t& last)
+{
+    using namespace std::string_view_literals;
+    static const auto UNIT = "bytes="sv;
+
+    auto number = [](std::string_view str, uint64_t& value)
+    {
+        auto end = str.data() + str.size();
+        auto result = std::from_chars(str.data(), end, value);
+        return !str.empty() && result.ec == std::errc() && result.ptr == end;
+    };
+
+    if (range.substr(0, UNIT.size()) != UNIT)
+    {
+        return Range::Ignored;
+    }
+
+    range.remove_prefix(UNIT.size());
+    auto dash = range.find('-');
+    if (dash == std::string_view::npos || range.find(',') != std::string_view::npos)
+    {
+        return Range::Ignored;
+    }
+
+    auto first_str = range.substr(0, dash);
+    auto last_str = range.substr(dash + 1);
+    if (first_str.empty())
+    {
+        uint64_t suffix;
+        if (!number(last_str, suffix))
+        {
+            return Range::Ignored;
+        }
+
+        if (!suffix || !size)
+        {
+            return Range::NotSatisfiable;
+        }
+
+        first = size - std::min(suffix, size);
+        last = size - 1;
+        return Range::Satisfiable;
+    }
+
+    if (!number(first_str, first))
+    {
+        return Range::Ignored;
+    }
+
+    last = size - 1;
+    if (!last_str.empty())
+    {
+        if (!number(last_str, last) || last < first)
+        {
+            return Range::Ignored;
+        }
+        last = std::min(last, size - 1);
+    }
+
+    return first < size ? Range::Satisfiable : Range::NotSatisfiable;
+}
+
+Response& Response::setBodyFile(const std::string& path, std::string_view range)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::system_category(), "Cannot open: " + path);
+    }
+
+    struct stat st;
+    int error = ::fstat(fd, &st) != 0 ? errno : S_ISREG(st.st_mode) ? 0 : EINVAL;
+    if (error)
+    {
+        ::close(fd);
+        throw std::system_error(error, std::system_category(), "Cannot serve: " + path);
+    }
+
+    uint64_t size = st.st_size;
+    uint64_t first = 0, last = 0;
+    auto result = range.empty() ? Range::Ignored : parse_range(range, size, first, last);
+    if (result == Range::NotSatisfiable)
+    {
+        ::close(fd);
+        setCode(HttpCode::RequestedRangeNotSatisfiable).setBody(std::string_view());
+        addHeader("Content-Range", "bytes */" + std::to_string(size));
+        return *this;
+    }
+
+    setBodyFile(fd, 0, size);
+    addHeader("Accept-Ranges", "bytes");
+    if (result == Range::Satisfiable)
+    {
+        setCode(HttpCode::PartialContent);
+        file_begin_ = file_offset_ = first;
+        file_end_ = last + 1;
+        addHeader(
+            "Content-Range",
+            "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/"
+                + std::to_string(size)
+        );
+    }
+    else
+    {
+        setCode(HttpCode::Ok);
+    }
+
+    return *this;
+}
+
+boost::system::error_code Response::send_file(int socket)
+{
+    while (file_offset_ < file_end_)
+    {
+        off_t offset = file_offset_;
+        auto count = std::min<uint64_t>(file_end_ - file_offset_, 1 << 30);
+        auto n = ::sendfile(socket, file_->fd, &offset, count);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return boost::asio::error::would_block;
+            }
+
+            return {errno, boost::system::system_category()};
+        }
+
+        if (n == 0)
+        {
+            // The file is shorter than announced
+            return boost::asio::error::eof;
+        }
+
+        file_offset_ += n;
+    }
+
+    file_.reset();
+    return {};
+}
+
+boost::system::error_code Response::read_file_chunk()
+{
+    file_chunk_.clear();
+    if (file_offset_ == file_end_)
+    {
+        file_.reset();
+        return {};
+    }
+
+    file_chunk_.resize(std::min<uint64_t>(file_end_ - file_offset_, FILE_CHUNK_SIZE));
+    for (;;)
+    {
+        auto n = ::pread(file_->fd, file_chunk_.data(), file_chunk_.size(), file_offset_);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            file_chunk_.clear();
+            return {errno, boost::system::system_category()};
+        }
+
+        if (n == 0)
+        {
+            file_chunk_.clear();
+            return boost::asio::error::eof;
+        }
+
+        file_chunk_.resize(n);
+        file_offset_ += n;
+        return {};
+    }
+}
+
+void Response::prepare_buffers()
+{
+    using namespace std::string_view_literals;
+    static const std::string_view te = "Transfer-Encoding: chunked\r\n"sv;
+    static const std::string_view cl = "Content-Length: "sv;
+
+    auto append = [this](std::string_view str)
+    {
+        head_.insert(head_.end(), str.begin(), str.end());
+    };
+
+    // The headers of the representation, without a body nor its length.
+    bool not_modified = code_ == HttpCode::NotModified && !is_chunked_enconding() && !file_;
+    char last_modified[HTTP_DATE_SIZE];
+    if (last_modified_ != -1)
+    {
+        format_http_date(last_modified_, last_modified);
+    }
+
+    bool add_date = add_date_;
+    bool add_server = !server_line_.empty();
+    bool has_encoding = false;
+    std::string_view content_type;
+    size_t size = 64 + te.size() + server_line_.size() + (add_date ? HTTP_DATE_SIZE + 8 : 0)
+                  + etag_.size() + 16 + (last_modified_ != -1 ? HTTP_DATE_SIZE + 17 : 0);
+    for (const auto& header : headers_)
+    {
+        size += header.first.size() + header.second.size() + 4;
+        if (add_date || add_server || compression_enabled_)
+        {
+            auto id = header_id_from(header.first);
+            add_date = add_date && id != HeaderId::Date;
+            add_server = add_server && id != HeaderId::Server;
+            has_encoding = has_encoding || id == HeaderId::ContentEncoding;
+            if (id == HeaderId::ContentType)
+            {
+                content_type = header.second;
+            }
+        }
+    }
+
+    // Chosen before the head is written, a fixed body is only sent
+    // compressed if it shrinks.
+    bool vary = should_compress(content_type, has_encoding);
+    body_compressed_ = false;
+    helper::Deflater::release(std::move(deflater_));
+    if (vary && coding_ != helper::ContentCoding::Identity && !not_modified)
+    {
+        if (is_chunked_enconding())
+        {
+            deflater_ = helper::Deflater::acquire(coding_, compression_.level);
+        }
+        else
+        {
+            body_compressed_ = compress_body();
+        }
+    }
+
+    // Kept from one response to the other, it only allocates when a
+    // response has more headers than the previous ones.
+    head_.clear();
+    head_.reserve(size);
+
+    auto line = status_line(code_);
+    if (line.empty())
+    {
+        char fallback[32];
+        auto n = std::snprintf(fallback, sizeof(fallback), "HTTP/1.1 %u Unknown\r\n", unsigned(code_));
+        append({fallback, size_t(n)});
+    }
+    else
+    {
+        append(line);
+    }
+
+    for (const auto& header : headers_)
+    {
+        append(header.first);
+        append({HEADER_SEPARATOR, sizeof(HEADER_SEPARATOR)});
+        append(header.second);
+        append({HTTP_DELIMITER, sizeof(HTTP_DELIMITER)});
+    }
+
+    if (add_date)
+    {
+        append(date_header());
+    }
+
+    if (add_server)
+    {
+        append(server_line_);
+    }
+
+    if (!etag_.empty())
+    {
+        // The variant for this coding is another representation, its tag
+        // gets the coding as a suffix.
+        append("ETag: "sv);
+        if (vary && coding_ != helper::ContentCoding::Identity)
+        {
+            append({etag_.data(), etag_.size() - 1});
+            append("-"sv);
+            append(helper::to_string(coding_));
+            append("\""sv);
+        }
+        else
+        {
+            append(etag_);
+        }
+        append({HTTP_DELIMITER, sizeof(HTTP_DELIMITER)});
+    }
+
+    if (last_modified_ != -1)
+    {
+        append("Last-Modified: "sv);
+        append({last_modified, HTTP_DATE_SIZE});
+        append({HTTP_DELIMITER, sizeof(HTTP_DELIMITER)});
+    }
+
+    if (vary)
+    {
+        append("Vary: Accept-Encoding\r\n"sv);
+    }
+
+    if (deflater_ || body_compressed_)
+    {
+        append("Content-Encoding: "sv);
+        append(helper::to_string(coding_));
+        append({HTTP_DELIMITER, sizeof(HTTP_DELIMITER)});
+    }
+
+    if (is_chunked_enconding())
+    {
+        append(te);
+    }
+    else if (!not_modified)
+    {
+        append(cl);
+        char length[24];
+        auto body_size = body_compressed_ ? compressed_.size() : bodySize();
+        auto result = std::to_chars(std::begin(length), std::end(length), body_size);
+        append({length, size_t(result.ptr - length)});
+        append({HTTP_DELIMITER, sizeof(HTTP_DELIMITER)});
+    }
+
+    append({HTTP_DELIMITER, sizeof(HTTP_DELIMITER)});
+
+    buffers_.clear();
+    buffers_.emplace_back(boost::asio::buffer(head_));
+    file_offset_ = file_begin_;
+    if (body_compressed_)
+    {
+        buffers_.emplace_back(boost::asio::buffer(compressed_));
+    }
+    else if (!is_chunked_enconding() && !file_ && !not_modified)
+    {
+        if (!body_.empty())
+        {
+            buffers_.emplace_back(boost::asio::buffer(body_));
+        }
+
+        for (const auto& segment : segments_)
+        {
+            buffers_.emplace_back(segment.data);
+        }
+    }
+}
+
+void Response::serialize(std::vector<char>& out)
+{
+    if (is_chunked_enconding() || file_)
+    {
+        throw std::logic_error("A chunked or file response cannot be serialized");
+    }
+
+    prepare_buffers();
+    out.reserve(out.size() + boost::asio::buffer_size(buffers_));
+    for (const auto& buffer : buffers_)
+    {
+        auto data = static_cast<const char*>(buffer.data());
+        out.insert(out.end(), data, data + buffer.size());
+    }
+}
+
+void Response::serialize(std::vector<char>& out, std::vector<QueuedSegment>& segments)
+{
+    if (is_chunked_enconding() || file_)
+    {
+        throw std::logic_error("A chunked or file response cannot be serialized");
+    }
+
+    // The segments are in buffers_ in their order, unless the body has been
+    // compressed or dropped.
+    prepare_buffers();
+    size_t next = 0;
+    for (const auto& buffer : buffers_)
+    {
+        if (next < segments_.size() && buffer.data() == segments_[next].data.data()
+            && buffer.size() == segments_[next].data.size())
+        {
+            segments.push_back({out.size(), segments_[next++]});
+            continue;
+        }
+
+        auto data = static_cast<const char*>(buffer.data());
+        out.insert(out.end(), data, data + buffer.size());
+    }
+}
+
 Response& Response::setBody(ChunkedResponseCallback callback)
 {
     if (callback)
     {
         body_.clear();
+        segments_.clear();
+        file_.reset();
+        chunk_stream_.reset();
         chunkedBodyCallback_ = std::move(callback);
         return *this;
     }
@@ -124,5 +757,179 @@ Response& Response::setBody(ChunkedResponseCallback callback)
     );
 }
 
+Response& Response::setBody(std::shared_ptr<helper::ChunkStream> stream)
+{
+    if (!stream)
+    {
+        throw std::invalid_argument("Setting chunked response body to a null stream");
+    }
+
+    setBody(std::string_view());
+    chunk_stream_ = std::move(stream);
+    return *this;
+}
+
+// Chunks up to this size are copied next to their framing, a write is
+// cheaper with fewer and larger buffers.
+static constexpr size_t COPY_CHUNK_SIZE = 2048;
+
+void Response::start_chunks() noexcept
+{
+    coalesced_.clear();
+    compressed_.clear();
+    chunk_pieces_.clear();
+}
+
+void Response::append_coalesced(const char* data, size_t size)
+{
+    if (chunk_pieces_.empty() || chunk_pieces_.back().data)
+    {
+        chunk_pieces_.push_back({nullptr, coalesced_.size(), 0});
+    }
+    coalesced_.insert(coalesced_.end(), data, data + size);
+    chunk_pieces_.back().size += size;
+}
+
+bool Response::add_chunk(std::string_view chunk, bool external)
+{
+    if (deflater_)
+    {
+        deflater_->compress(chunk, compressed_, false, false);
+        return true;
+    }
+
+    return frame_chunk(chunk, external);
+}
+
+bool Response::frame_chunk(std::string_view chunk, bool external)
+{
+    char header[18];
+    auto result = std::to_chars(header, header + 16, chunk.size(), 16);
+    *result.ptr++ = '\r';
+    *result.ptr++ = '\n';
+    append_coalesced(header, result.ptr - header);
+
+    bool copied = !external || chunk.size() <= COPY_CHUNK_SIZE;
+    if (copied)
+    {
+        append_coalesced(chunk.data(), chunk.size());
+    }
+    else
+    {
+        chunk_pieces_.push_back({chunk.data(), 0, chunk.size()});
+    }
+
+    append_coalesced(HTTP_DELIMITER, sizeof(HTTP_DELIMITER));
+    return copied;
+}
+
+void Response::add_end_of_stream()
+{
+    append_coalesced(END_OF_STREAM_MARKER, sizeof(END_OF_STREAM_MARKER));
+}
+
+void Response::finish_compressed_chunk(bool last)
+{
+    // Flushed at every write so that the client can decode what it
+    // received without waiting for the rest.
+    deflater_->compress({}, compressed_, true, last);
+    if (!compressed_.empty())
+    {
+        frame_chunk({compressed_.data(), compressed_.size()}, true);
+    }
+
+    if (last)
+    {
+        helper::Deflater::release(std::move(deflater_));
+    }
+}
+
+bool Response::should_compress(std::string_view content_type, bool has_encoding) const noexcept
+{
+    if (!compression_enabled_ || !compress_ || has_encoding || file_)
+    {
+        return false;
+    }
+
+    // These have no body, a NotModified varies as the full response would
+    // have.
+    auto code = unsigned(code_);
+    if (code < 200 || code_ == HttpCode::NoContent)
+    {
+        return false;
+    }
+
+    if (code_ == HttpCode::NotModified)
+    {
+        if (not_modified_size_ == 0 || not_modified_size_ < compression_.min_size)
+        {
+            return false;
+        }
+    }
+    else if (!is_chunked_enconding() && bodySize() < compression_.min_size)
+    {
+        return false;
+    }
+
+    return helper::is_compressible(content_type);
+}
+
+bool Response::compress_body()
+{
+    auto deflater = helper::Deflater::acquire(coding_, compression_.level);
+    compressed_.clear();
+    compressed_.reserve(bodySize() / 2);
+    deflater->compress({body_.data(), body_.size()}, compressed_, false, segments_.empty());
+    for (size_t i = 0; i < segments_.size(); ++i)
+    {
+        const auto& data = segments_[i].data;
+        deflater->compress(
+            {static_cast<const char*>(data.data()), data.size()},
+            compressed_,
+            false,
+            i + 1 == segments_.size()
+        );
+    }
+    helper::Deflater::release(std::move(deflater));
+    return compressed_.size() < bodySize();
+}
+
+void Response::prepare_chunk_buffers()
+{
+    // coalesced_ does not move anymore, the buffers can point into it.
+    buffers_.clear();
+    buffers_.reserve(chunk_pieces_.size());
+    for (const auto& piece : chunk_pieces_)
+    {
+        buffers_.emplace_back(
+            boost::asio::buffer(piece.data ? piece.data : coalesced_.data() + piece.offset, piece.size)
+        );
+    }
+}
+
+void Response::abortStream() noexcept
+{
+    // chunk_stream_ is not replaced while it is being written.
+    if (streaming_)
+    {
+        chunk_stream_->abort(boost::asio::error::operation_aborted);
+    }
+}
+
+void Response::release_stream()
+{
+    if (chunk_timer_armed_)
+    {
+        chunk_timer_armed_ = false;
+        chunk_timer_->cancel();
+    }
+
+    if (chunk_stream_ && streaming_)
+    {
+        streaming_ = false;
+        chunk_stream_->fail(boost::asio::error::operation_aborted);
+    }
+}
+
 } // namespace HTTP
 } // namespace HTTPP
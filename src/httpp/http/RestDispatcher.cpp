@@ -97,6 +97,20 @@ RestDispatcher::RestDispatcher(HttpServer& server)
 
 RestDispatcher::~RestDispatcher() = default;
 
+Route::WithoutBodyHandler RestDispatcher::serve(std::shared_ptr<const StaticResponse> response)
+{
+    if (!response)
+    {
+        throw std::invalid_argument("Null static response");
+    }
+
+    return [response = std::move(response)](HTTP::Connection* conn)
+    {
+        response->apply(conn->request(), conn->response());
+        conn->sendResponse();
+    };
+}
+
 struct Comparator
 {
     template <typename Pair, typename StrLike>
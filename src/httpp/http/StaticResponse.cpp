@@ -0,0 +1,180 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include "httpp/http/StaticResponse.hpp"
+
+#include <cstdio>
+#include <functional>
+
+#if HTTPP_WITH_BROTLI
+#    include <brotli/encode.h>
+#endif
+
+#include "httpp/http/Request.hpp"
+#include "httpp/http/Response.hpp"
+
+namespace HTTPP
+{
+namespace HTTP
+{
+
+using helper::ContentCoding;
+
+// Built once, they are worth the slowest and best levels.
+static constexpr int ZLIB_LEVEL = 9;
+
+static std::string deflate(ContentCoding coding, const std::string& body)
+{
+    auto deflater = helper::Deflater::acquire(coding, ZLIB_LEVEL);
+    std::vector<char> out;
+    deflater->compress(body, out, false, true);
+    helper::Deflater::release(std::move(deflater));
+    return std::string(out.begin(), out.end());
+}
+
+#if HTTPP_WITH_BROTLI
+static std::string brotli(const std::string& body)
+{
+    std::string out(BrotliEncoderMaxCompressedSize(body.size()), 0);
+    size_t size = out.size();
+    if (!BrotliEncoderCompress(
+            BROTLI_MAX_QUALITY,
+            BROTLI_DEFAULT_WINDOW,
+            BROTLI_MODE_GENERIC,
+            body.size(),
+            reinterpret_cast<const uint8_t*>(body.data()),
+            &size,
+            reinterpret_cast<uint8_t*>(out.data())
+        ))
+    {
+        return {};
+    }
+
+    out.resize(size);
+    return out;
+}
+#endif
+
+// The opaque part of an entity tag header, "W/" marks a weak one. A
+// malformed tag is left empty, the body is hashed instead.
+static void parse_etag(std::string_view value, std::string& tag, bool& weak)
+{
+    bool is_weak = value.substr(0, 2) == "W/";
+    if (is_weak)
+    {
+        value.remove_prefix(2);
+    }
+
+    tag.clear();
+    if (value.size() > 2 && value.front() == '"' && value.back() == '"')
+    {
+        value = value.substr(1, value.size() - 2);
+        if (value.find('"') == std::string_view::npos)
+        {
+            tag = value;
+        }
+    }
+    weak = is_weak && !tag.empty();
+}
+
+StaticResponse::StaticResponse(HttpCode code, std::string body, std::vector<Header> headers)
+: code_(code)
+, headers_(std::move(headers))
+{
+    std::string_view content_type;
+    std::string tag;
+    for (auto it = headers_.begin(); it != headers_.end();)
+    {
+        auto id = header_id_from(it->first);
+        if (id == HeaderId::ETag)
+        {
+            // Served by setETag, with a suffix per variant
+            parse_etag(it->second, tag, weak_etag_);
+            it = headers_.erase(it);
+            continue;
+        }
+
+        if (id == HeaderId::ContentType)
+        {
+            content_type = it->second;
+        }
+        ++it;
+    }
+
+    auto identity = std::make_shared<const std::string>(std::move(body));
+    if (!identity->empty() && helper::is_compressible(content_type))
+    {
+        auto keep = [this, &identity](ContentCoding coding, std::string compressed)
+        {
+            if (!compressed.empty() && compressed.size() < identity->size())
+            {
+                bodies_[size_t(coding)] = std::make_shared<const std::string>(std::move(compressed));
+                vary_ = true;
+            }
+        };
+
+        keep(ContentCoding::Gzip, deflate(ContentCoding::Gzip, *identity));
+        keep(ContentCoding::Deflate, deflate(ContentCoding::Deflate, *identity));
+#if HTTPP_WITH_BROTLI
+        keep(ContentCoding::Brotli, brotli(*identity));
+#endif
+    }
+
+    if (tag.empty())
+    {
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016zx", std::hash<std::string_view>()(*identity));
+        tag = hash;
+    }
+
+    for (size_t i = 0; i < etags_.size(); ++i)
+    {
+        etags_[i] = tag;
+        if (ContentCoding(i) != ContentCoding::Identity)
+        {
+            etags_[i] += '-';
+            etags_[i] += helper::to_string(ContentCoding(i));
+        }
+    }
+
+    bodies_[size_t(ContentCoding::Identity)] = std::move(identity);
+}
+
+void StaticResponse::apply(const Request& request, Response& response) const
+{
+    response.setCode(code_).setCompression(false);
+    for (const auto& header : headers_)
+    {
+        response.addHeader(header.first, header.second);
+    }
+
+    auto coding = ContentCoding::Identity;
+    if (vary_)
+    {
+        response.addHeader("Vary", "Accept-Encoding");
+        helper::AvailableCodings available;
+        for (size_t i = 0; i < available.size(); ++i)
+        {
+            available[i] = bodies_[i] != nullptr;
+        }
+        coding = helper::negotiate_coding(request.header(HeaderId::AcceptEncoding), available);
+    }
+
+    if (coding != ContentCoding::Identity)
+    {
+        response.addHeader("Content-Encoding", std::string(helper::to_string(coding)));
+    }
+
+    response.setETag(etags_[size_t(coding)], weak_etag_);
+    response.setBody(body(coding));
+}
+
+} // namespace HTTP
+} // namespace HTTPP
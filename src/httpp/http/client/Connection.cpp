@@ -254,6 +254,8 @@ void Connection::configureRequest(HTTPP::HTTP::Method method)
     case HTTPP::HTTP::Method::OPTIONS:
     case HTTPP::HTTP::Method::TRACE:
     case HTTPP::HTTP::Method::CONNECT:
+    case HTTPP::HTTP::Method::PATCH:
+    case HTTPP::HTTP::Method::EXTENSION:
         auto method_str = to_string(method);
         conn_setopt(CURLOPT_CUSTOMREQUEST, method_str.data());
         break;
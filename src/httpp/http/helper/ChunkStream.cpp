@@ -0,0 +1,225 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include "httpp/http/helper/ChunkStream.hpp"
+
+#include <stdexcept>
+
+namespace HTTPP
+{
+namespace HTTP
+{
+namespace helper
+{
+
+ChunkStream::ChunkStream(size_t max_queued)
+: max_queued_(max_queued)
+{
+}
+
+bool ChunkStream::push(std::string chunk, bool flush)
+{
+    std::function<void()> wakeup;
+    bool accepted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_)
+        {
+            throw std::logic_error("Chunk pushed after the end of the stream");
+        }
+
+        if (error_)
+        {
+            return false;
+        }
+
+        // The writer is told about the first chunk to start the delay
+        // after which it is written.
+        bool first = queue_.empty();
+        if (!chunk.empty())
+        {
+            queued_ += chunk.size();
+            queue_.emplace_back(std::move(chunk));
+        }
+
+        flush_ = flush_ || flush;
+        if (!queue_.empty() && (first || flush_ || queued_ >= wakeup_bytes_))
+        {
+            wakeup.swap(wakeup_);
+        }
+
+        accepted = queued_ < max_queued_;
+        full_ = full_ || !accepted;
+    }
+
+    if (wakeup)
+    {
+        wakeup();
+    }
+    return accepted;
+}
+
+void ChunkStream::flush()
+{
+    std::function<void()> wakeup;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush_ = true;
+        if (!queue_.empty())
+        {
+            wakeup.swap(wakeup_);
+        }
+    }
+
+    if (wakeup)
+    {
+        wakeup();
+    }
+}
+
+void ChunkStream::close()
+{
+    std::function<void()> wakeup;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        wakeup.swap(wakeup_);
+    }
+
+    if (wakeup)
+    {
+        wakeup();
+    }
+}
+
+void ChunkStream::onReady(ReadyCallback callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_ = std::move(callback);
+}
+
+boost::system::error_code ChunkStream::error() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+ChunkStream::Status ChunkStream::take(
+    std::vector<std::string>& out, size_t min_bytes, std::function<void()> wakeup
+)
+{
+    ReadyCallback ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_)
+        {
+            return Status::Failed;
+        }
+
+        if (queue_.empty())
+        {
+            if (closed_)
+            {
+                return Status::End;
+            }
+
+            wakeup_bytes_ = min_bytes;
+            wakeup_ = std::move(wakeup);
+            return Status::Wait;
+        }
+
+        if (queued_ < min_bytes && !flush_ && !closed_)
+        {
+            wakeup_bytes_ = min_bytes;
+            wakeup_ = std::move(wakeup);
+            return Status::Pending;
+        }
+
+        for (auto& chunk : queue_)
+        {
+            out.emplace_back(std::move(chunk));
+        }
+        queue_.clear();
+        queued_ = 0;
+        flush_ = false;
+
+        if (full_)
+        {
+            full_ = false;
+            ready = ready_;
+        }
+    }
+
+    // The chunks taken are being written while the producer makes the
+    // next ones.
+    if (ready)
+    {
+        ready({});
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_ && queue_.empty() ? Status::Last : Status::Data;
+}
+
+void ChunkStream::fail(const boost::system::error_code& ec)
+{
+    ReadyCallback ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_)
+        {
+            return;
+        }
+
+        error_ = ec;
+        queue_.clear();
+        queued_ = 0;
+        wakeup_ = nullptr;
+        ready = ready_;
+    }
+
+    if (ready)
+    {
+        ready(ec);
+    }
+}
+
+void ChunkStream::abort(const boost::system::error_code& ec)
+{
+    ReadyCallback ready;
+    std::function<void()> wakeup;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_)
+        {
+            return;
+        }
+
+        error_ = ec;
+        queue_.clear();
+        queued_ = 0;
+        wakeup.swap(wakeup_);
+        ready = ready_;
+    }
+
+    if (ready)
+    {
+        ready(ec);
+    }
+
+    if (wakeup)
+    {
+        wakeup();
+    }
+}
+
+} // namespace helper
+} // namespace HTTP
+} // namespace HTTPP
@@ -0,0 +1,179 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include "httpp/http/helper/ChunkedDecoder.hpp"
+
+#include <algorithm>
+
+namespace HTTPP
+{
+namespace HTTP
+{
+namespace helper
+{
+
+static int hex_value(char c) noexcept
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+void ChunkedDecoder::reset() noexcept
+{
+    state_ = State::Size;
+    remaining_ = 0;
+    digits_ = 0;
+}
+
+ChunkedDecoder::Status ChunkedDecoder::decode(const char*& data, const char* end, std::string_view& chunk)
+{
+    while (data != end)
+    {
+        char c = *data;
+        switch (state_)
+        {
+        case State::Size:
+        {
+            auto value = hex_value(c);
+            if (value >= 0)
+            {
+                // More digits than a size_t can hold
+                if (++digits_ > sizeof(size_t) * 2)
+                {
+                    state_ = State::Error;
+                    return Status::Error;
+                }
+                remaining_ = (remaining_ << 4) | value;
+            }
+            else if (digits_ && (c == ';' || c == ' ' || c == '\t'))
+            {
+                state_ = State::Extension;
+            }
+            else if (digits_ && c == '\r')
+            {
+                state_ = State::SizeLF;
+            }
+            else
+            {
+                state_ = State::Error;
+                return Status::Error;
+            }
+            ++data;
+            break;
+        }
+        case State::Extension:
+            if (c == '\r')
+            {
+                state_ = State::SizeLF;
+            }
+            ++data;
+            break;
+        case State::SizeLF:
+            if (c != '\n')
+            {
+                state_ = State::Error;
+                return Status::Error;
+            }
+            state_ = remaining_ ? State::Data : State::Trailer;
+            digits_ = 0;
+            ++data;
+            break;
+        case State::Data:
+        {
+            auto n = std::min(remaining_, size_t(end - data));
+            chunk = std::string_view(data, n);
+            data += n;
+            remaining_ -= n;
+            if (!remaining_)
+            {
+                state_ = State::DataCR;
+            }
+            return Status::Data;
+        }
+        case State::DataCR:
+            if (c != '\r')
+            {
+                state_ = State::Error;
+                return Status::Error;
+            }
+            state_ = State::DataLF;
+            ++data;
+            break;
+        case State::DataLF:
+            if (c != '\n')
+            {
+                state_ = State::Error;
+                return Status::Error;
+            }
+            state_ = State::Size;
+            ++data;
+            break;
+        case State::Trailer:
+            // Trailer fields are skipped, an empty line ends the body.
+            state_ = c == '\r' ? State::EndLF : State::TrailerLine;
+            ++data;
+            break;
+        case State::TrailerLine:
+            if (c == '\r')
+            {
+                state_ = State::TrailerLineLF;
+            }
+            ++data;
+            break;
+        case State::TrailerLineLF:
+            if (c != '\n')
+            {
+                state_ = State::Error;
+                return Status::Error;
+            }
+            state_ = State::Trailer;
+            ++data;
+            break;
+        case State::EndLF:
+            if (c != '\n')
+            {
+                state_ = State::Error;
+                return Status::Error;
+            }
+            state_ = State::Done;
+            ++data;
+            return Status::Done;
+        case State::Done:
+            return Status::Done;
+        case State::Error:
+            return Status::Error;
+        }
+    }
+
+    if (state_ == State::Done)
+    {
+        return Status::Done;
+    }
+
+    return state_ == State::Error ? Status::Error : Status::NeedMore;
+}
+
+} // namespace helper
+} // namespace HTTP
+} // namespace HTTPP
@@ -0,0 +1,312 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include "httpp/http/helper/Compression.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+namespace HTTPP
+{
+namespace HTTP
+{
+namespace helper
+{
+using namespace std::string_view_literals;
+
+std::string_view to_string(ContentCoding coding)
+{
+    switch (coding)
+    {
+    default:
+    case ContentCoding::Identity:
+        return "identity"sv;
+    case ContentCoding::Gzip:
+        return "gzip"sv;
+    case ContentCoding::Deflate:
+        return "deflate"sv;
+    case ContentCoding::Brotli:
+        return "br"sv;
+    }
+}
+
+static inline bool is_iequal(std::string_view s1, std::string_view s2)
+{
+    return s1.size() == s2.size() && ::strncasecmp(s1.data(), s2.data(), s1.size()) == 0;
+}
+
+static std::string_view trim(std::string_view str)
+{
+    static const char WS[] = " \t";
+    auto begin = str.find_first_not_of(WS);
+    if (begin == std::string_view::npos)
+    {
+        return {};
+    }
+
+    return str.substr(begin, str.find_last_not_of(WS) - begin + 1);
+}
+
+// The q parameter of an Accept-Encoding element, in thousandths, or -1 when
+// it is not a qvalue: "0" [ "." 0*3DIGIT ] / "1" [ "." 0*3("0") ]
+static int quality(std::string_view params) noexcept
+{
+    for (;;)
+    {
+        auto semicolon = params.find(';');
+        if (semicolon == std::string_view::npos)
+        {
+            return 1000;
+        }
+
+        params.remove_prefix(semicolon + 1);
+        auto param = trim(params.substr(0, params.find(';')));
+        if (param.size() < 2 || (param[0] | 0x20) != 'q' || param[1] != '=')
+        {
+            continue;
+        }
+
+        param.remove_prefix(2);
+        if (param.empty() || param.size() > 5 || (param[0] != '0' && param[0] != '1')
+            || (param.size() > 1 && param[1] != '.'))
+        {
+            return -1;
+        }
+
+        int value = param[0] == '1' ? 1000 : 0;
+        int scale = 100;
+        for (size_t i = 2; i < param.size(); ++i, scale /= 10)
+        {
+            if (param[i] < '0' || param[i] > '9' || (value == 1000 && param[i] != '0'))
+            {
+                return -1;
+            }
+            value += (param[i] - '0') * scale;
+        }
+        return value;
+    }
+}
+
+ContentCoding negotiate_coding(std::string_view accept_encoding, bool brotli) noexcept
+{
+    return negotiate_coding(accept_encoding, AvailableCodings{true, true, true, brotli});
+}
+
+ContentCoding negotiate_coding(std::string_view accept_encoding, const AvailableCodings& available) noexcept
+{
+    int qualities[NB_CONTENT_CODINGS] = {-1, -1, -1, -1};
+    int any = -1;
+    while (!accept_encoding.empty())
+    {
+        auto comma = accept_encoding.find(',');
+        auto element = accept_encoding.substr(0, comma);
+        accept_encoding.remove_prefix(comma == std::string_view::npos ? accept_encoding.size() : comma + 1);
+
+        auto name = trim(element.substr(0, element.find(';')));
+        auto q = quality(element);
+        if (q < 0)
+        {
+            // A malformed weight: the element is ignored
+            continue;
+        }
+
+        if (is_iequal(name, "gzip"sv) || is_iequal(name, "x-gzip"sv))
+        {
+            qualities[size_t(ContentCoding::Gzip)] = q;
+        }
+        else if (is_iequal(name, "deflate"sv))
+        {
+            qualities[size_t(ContentCoding::Deflate)] = q;
+        }
+        else if (is_iequal(name, "br"sv))
+        {
+            qualities[size_t(ContentCoding::Brotli)] = q;
+        }
+        else if (name == "*"sv)
+        {
+            any = q;
+        }
+    }
+
+    // In order of preference for the same quality
+    static const ContentCoding PREFERRED[] = {ContentCoding::Brotli, ContentCoding::Gzip, ContentCoding::Deflate};
+    auto coding = ContentCoding::Identity;
+    int best = 0;
+    for (auto candidate : PREFERRED)
+    {
+        auto q = qualities[size_t(candidate)] < 0 ? any : qualities[size_t(candidate)];
+        if (available[size_t(candidate)] && q > best)
+        {
+            coding = candidate;
+            best = q;
+        }
+    }
+
+    return coding;
+}
+
+bool is_compressible(std::string_view content_type) noexcept
+{
+    auto type = trim(content_type.substr(0, content_type.find(';')));
+    auto starts_with = [type](std::string_view prefix)
+    {
+        return type.size() >= prefix.size() && is_iequal(type.substr(0, prefix.size()), prefix);
+    };
+
+    if (starts_with("image/"sv))
+    {
+        return is_iequal(type, "image/svg+xml"sv) || is_iequal(type, "image/x-icon"sv)
+               || is_iequal(type, "image/bmp"sv);
+    }
+
+    static const std::string_view COMPRESSED[] = {
+        "audio/"sv,
+        "video/"sv,
+        "font/woff"sv,
+        "application/zip"sv,
+        "application/gzip"sv,
+        "application/x-gzip"sv,
+        "application/x-bzip2"sv,
+        "application/x-xz"sv,
+        "application/x-7z-compressed"sv,
+        "application/x-rar-compressed"sv,
+        "application/zstd"sv,
+        "application/pdf"sv,
+        "application/octet-stream"sv,
+    };
+
+    for (auto prefix : COMPRESSED)
+    {
+        if (starts_with(prefix))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct Deflater::Stream
+{
+    z_stream z = {};
+};
+
+// Deflaters kept by each thread for each coding, at most this many.
+static constexpr size_t MAX_POOLED_DEFLATERS = 8;
+
+struct DeflaterPool
+{
+    std::vector<std::unique_ptr<Deflater>> gzip;
+    std::vector<std::unique_ptr<Deflater>> deflate;
+
+    std::vector<std::unique_ptr<Deflater>>& operator[](ContentCoding coding)
+    {
+        return coding == ContentCoding::Gzip ? gzip : deflate;
+    }
+};
+
+static thread_local DeflaterPool deflater_pool;
+
+std::unique_ptr<Deflater> Deflater::acquire(ContentCoding coding, int level)
+{
+    if (coding != ContentCoding::Gzip && coding != ContentCoding::Deflate)
+    {
+        throw std::invalid_argument("No deflater for this coding: " + std::string(to_string(coding)));
+    }
+
+    auto& pool = deflater_pool[coding];
+    while (!pool.empty())
+    {
+        auto deflater = std::move(pool.back());
+        pool.pop_back();
+        if (deflater->level_ == level)
+        {
+            return deflater;
+        }
+    }
+
+    return std::unique_ptr<Deflater>(new Deflater(coding, level));
+}
+
+void Deflater::release(std::unique_ptr<Deflater> deflater) noexcept
+{
+    if (!deflater)
+    {
+        return;
+    }
+
+    auto& pool = deflater_pool[deflater->coding_];
+    if (pool.size() < MAX_POOLED_DEFLATERS)
+    {
+        deflater->reset();
+        pool.emplace_back(std::move(deflater));
+    }
+}
+
+Deflater::Deflater(ContentCoding coding, int level)
+: stream_(new Stream)
+, coding_(coding)
+, level_(level)
+{
+    // 16 more window bits asks zlib for the gzip wrapper
+    int window_bits = coding == ContentCoding::Gzip ? 15 + 16 : 15;
+    if (deflateInit2(&stream_->z, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw std::runtime_error("Cannot initialize zlib");
+    }
+}
+
+Deflater::~Deflater()
+{
+    deflateEnd(&stream_->z);
+}
+
+void Deflater::reset() noexcept
+{
+    deflateReset(&stream_->z);
+}
+
+void Deflater::compress(std::string_view in, std::vector<char>& out, bool flush, bool finish)
+{
+    auto& z = stream_->z;
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+    z.avail_in = uInt(in.size());
+
+    int mode = finish ? Z_FINISH : flush ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+    for (;;)
+    {
+        auto size = out.size();
+        auto room = std::max<size_t>(deflateBound(&z, z.avail_in), 64);
+        out.resize(size + room);
+        z.next_out = reinterpret_cast<Bytef*>(out.data() + size);
+        z.avail_out = uInt(room);
+
+        auto result = deflate(&z, mode);
+        out.resize(size + room - z.avail_out);
+        if (result == Z_STREAM_ERROR)
+        {
+            throw std::runtime_error("zlib deflate failed");
+        }
+
+        // Done once all the input is consumed and, when asked, flushed
+        if (z.avail_in == 0 && z.avail_out != 0 && (!finish || result == Z_STREAM_END))
+        {
+            return;
+        }
+    }
+}
+
+} // namespace helper
+} // namespace HTTP
+} // namespace HTTPP
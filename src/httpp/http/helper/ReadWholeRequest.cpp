@@ -1,8 +1,5 @@
 #include "httpp/http/helper/ReadWholeRequest.hpp"
 
-#include <algorithm>
-#include <cstring>
-
 #include "httpp/http/Connection.hpp"
 
 namespace HTTPP
@@ -31,30 +28,18 @@ ReadWholeRequest::ReadWholeRequest(Connection* conn, Callback cb, size_t size_li
 
 void ReadWholeRequest::start()
 {
-    auto& request = connection->request();
-    auto it = std::find_if(
-        request.headers.begin(),
-        request.headers.end(),
-        [](const HeaderRef& s)
-        {
-            return ::strncasecmp("Content-Length", s.first.data(), 14) == 0;
-        }
-    );
-
-    size_t size = 0;
-    if (it != request.headers.end())
+    if (connection->request().chunked)
     {
-        size = atoi(it->second.data());
+        body.clear();
+        connection->read_chunked(std::ref(*this));
+        return;
     }
 
+    size_t size = connection->request().content_length;
+
     if (size_limit && size > size_limit)
     {
-        connection->response()
-            .setCode(HttpCode::RequestEntityTooLarge)
-            .setBody("Size is limited to: " + std::to_string(size_limit));
-
-        // Do not send a response, it is up to the handle to decide what to do.
-        cb(Handle(this), boost::asio::error::message_size);
+        entity_too_large();
         return;
     }
 
@@ -74,6 +59,47 @@ void ReadWholeRequest::operator()(const boost::system::error_code& errc)
     cb(Handle(this), errc);
 }
 
+void ReadWholeRequest::operator()(const boost::system::error_code& errc, const char* data, size_t n)
+{
+    if (errc)
+    {
+        cb(Handle(this), errc);
+        return;
+    }
+
+    if (!data)
+    {
+        if (too_large)
+        {
+            entity_too_large();
+            return;
+        }
+
+        cb(Handle(this), errc);
+        return;
+    }
+
+    // The rest of the body still has to be consumed, it is dropped.
+    if (too_large || (size_limit && body.size() + n > size_limit))
+    {
+        too_large = true;
+        body.clear();
+        return;
+    }
+
+    body.insert(body.end(), data, data + n);
+}
+
+void ReadWholeRequest::entity_too_large()
+{
+    connection->response()
+        .setCode(HttpCode::RequestEntityTooLarge)
+        .setBody("Size is limited to: " + std::to_string(size_limit));
+
+    // Do not send a response, it is up to the handle to decide what to do.
+    cb(Handle(this), boost::asio::error::message_size);
+}
+
 } // namespace helper
 } // namespace HTTP
 } // namespace HTTPP
@@ -45,7 +45,7 @@ action start_key {
 
 action end_key {
     token_end = fpc;
-    request.headers.emplace_back(TOKEN_REF, "");
+    request.addHeader(TOKEN_REF);
     token_begin = token_end = nullptr;
 }
 
@@ -55,8 +55,13 @@ action start_value {
 
 action end_value {
     token_end = fpc;
-    request.headers.back().second = TOKEN_REF;
+    bool valid = request.setHeaderValue(TOKEN_REF);
     token_begin = token_end = nullptr;
+    if (!valid)
+    {
+        cs = http_error;
+        goto _out;
+    }
 }
 
 action start_qkey {
@@ -65,7 +70,7 @@ action start_qkey {
 
 action end_qkey {
     token_end = fpc;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
 
@@ -83,34 +88,99 @@ action start_method {
     token_begin = fpc;
 }
 
+action method_connect {
+    request.method = Method::CONNECT;
+    token_begin = nullptr;
+}
+
+action method_delete {
+    request.method = Method::DELETE_;
+    token_begin = nullptr;
+}
+
+action method_get {
+    request.method = Method::GET;
+    token_begin = nullptr;
+}
+
+action method_head {
+    request.method = Method::HEAD;
+    token_begin = nullptr;
+}
+
+action method_options {
+    request.method = Method::OPTIONS;
+    token_begin = nullptr;
+}
+
+action method_patch {
+    request.method = Method::PATCH;
+    token_begin = nullptr;
+}
+
+action method_post {
+    request.method = Method::POST;
+    token_begin = nullptr;
+}
+
+action method_put {
+    request.method = Method::PUT;
+    token_begin = nullptr;
+}
+
+action method_trace {
+    request.method = Method::TRACE;
+    token_begin = nullptr;
+}
+
 action end_method {
     token_end = fpc;
-    try
-    {
-        request.method = method_from(TOKEN_REF);
-    }
-    catch(...)
-    {
-        fbreak;
-    }
+    request.method = Method::EXTENSION;
+    request.method_name = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
 
 }%%
 
 namespace HTTPP { namespace HTTP {
-bool Parser::parse(const char* start,
-                   const char* end,
-                   size_t& consumed,
-                   Request& request)
+Parser::Result Parser::parse(State& state,
+                             const char* buffer,
+                             size_t n,
+                             Request& request)
 {
-    const char *p = start;
-    int cs;
+    const char *p = buffer + state.offset;
+    const char *pe = buffer + n;
+    int cs = state.cs;
+
+    // Only the beginning of a token can be pending from a previous call.
+    const char *token_begin = nullptr, *token_end;
+    if (state.token_begin != State::NO_TOKEN)
+    {
+        token_begin = buffer + state.token_begin;
+    }
 
-    const char *token_begin, *token_end;
+    if (cs < 0)
+    {
+        %% write init;
+    }
 
     %%{
-        method = ("GET" | "POST" | "HEAD" | "PUT" | "DELETE" | "OPTIONS" | "TRACE" | "CONNECT");
+        # Each known method leaves through its own final state, anything
+        # else made of tchars is an extension method.
+        known_method = ("CONNECT" %method_connect
+                        | "DELETE" %method_delete
+                        | "GET" %method_get
+                        | "HEAD" %method_head
+                        | "OPTIONS" %method_options
+                        | "PATCH" %method_patch
+                        | "POST" %method_post
+                        | "PUT" %method_put
+                        | "TRACE" %method_trace);
+        known_name = ("CONNECT" | "DELETE" | "GET" | "HEAD" | "OPTIONS"
+                      | "PATCH" | "POST" | "PUT" | "TRACE");
+        tchar = alnum | [!#$%&'*+\-.^_`|~];
+        extension_method = (tchar+ - known_name) %end_method;
+        method = known_method | extension_method;
 
         identifier = (alnum | '-')+;
 
@@ -124,7 +194,7 @@ bool Parser::parse(const char* start,
 
         major = digit >{ request.major = fc - '0';};
         minor = digit >{request.minor = fc - '0';};
-        status_line = (method >start_method %end_method) space query space "HTTP/" major "." minor "\r\n";
+        status_line = (method >start_method) space query space "HTTP/" major "." minor "\r\n";
 
         key = identifier >start_key %end_key;
         value = (any+ -- "\r\n") >start_value %end_value;
@@ -135,17 +205,39 @@ bool Parser::parse(const char* start,
                     fbreak;
                 };
 
-        write init;
-        write exec noend;
+        write exec;
     }%%
 
-    if (cs < http_first_final)
+    state.cs = cs;
+    state.offset = p - buffer;
+    state.token_begin = token_begin ? token_begin - buffer : State::NO_TOKEN;
+
+    if (cs == http_error)
+    {
+        return Result::Error;
+    }
+
+    if (cs >= http_first_final)
+    {
+        return Result::Complete;
+    }
+
+    return Result::Incomplete;
+}
+
+bool Parser::parse(const char* start,
+                   const char* end,
+                   size_t& consumed,
+                   Request& request)
+{
+    State state;
+    if (parse(state, start, end - start, request) != Result::Complete)
     {
-        GLOG(error) << "Invalid request read, cannot parse: " << std::string(p, end);
+        GLOG(error) << "Invalid request read, cannot parse: " << std::string(start, end);
         return false;
     }
 
-    consumed = p - start;
+    consumed = state.offset;
     return true;
 }
 
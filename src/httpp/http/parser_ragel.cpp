@@ -26,9 +26,9 @@
 #define TOKEN_REF std::string_view(token_begin, TOKEN_LEN)
 
 
-#line 27 "parser.c"
+#line 30 "parser.c"
 static const int http_start = 1;
-static const int http_first_final = 61;
+static const int http_first_final = 77;
 static const int http_error = 0;
 
 static const int http_en_main = 1;
@@ -38,415 +38,520 @@ static const int http_en_main = 1;
 
 
 
-#line 99 "parser.rl"
+#line 143 "parser.rl"
 
 
 namespace HTTPP { namespace HTTP {
-bool Parser::parse(const char* start,
-                   const char* end,
-                   size_t& consumed,
-                   Request& request)
+Parser::Result Parser::parse(State& state,
+                             const char* buffer,
+                             size_t n,
+                             Request& request)
 {
-    const char *p = start;
-    int cs;
+    const char *p = buffer + state.offset;
+    const char *pe = buffer + n;
+    int cs = state.cs;
 
-    const char *token_begin, *token_end;
+    // Only the beginning of a token can be pending from a previous call.
+    const char *token_begin = nullptr, *token_end;
+    if (state.token_begin != State::NO_TOKEN)
+    {
+        token_begin = buffer + state.token_begin;
+    }
 
-    
-#line 48 "parser.c"
+    if (cs < 0)
+    {
+        
+#line 65 "parser.c"
 	{
 	cs = http_start;
 	}
 
-#line 51 "parser.c"
+#line 165 "parser.rl"
+    }
+
+    
+#line 74 "parser.c"
 	{
+	if ( p == pe )
+		goto _test_eof;
 	switch ( cs )
 	{
 case 1:
 	switch( (*p) ) {
-		case 67: goto tr0;
+		case 33: goto tr0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 67: goto tr1;
 		case 68: goto tr2;
 		case 71: goto tr3;
 		case 72: goto tr4;
 		case 79: goto tr5;
 		case 80: goto tr6;
 		case 84: goto tr7;
+		case 123: goto st0;
+		case 125: goto st0;
 	}
+	if ( (*p) < 69 ) {
+		if ( (*p) < 42 ) {
+			if ( 35 <= (*p) && (*p) <= 39 )
+				goto tr0;
+		} else if ( (*p) > 57 ) {
+			if ( 65 <= (*p) && (*p) <= 66 )
+				goto tr0;
+		} else
+			goto tr0;
+	} else if ( (*p) > 70 ) {
+		if ( (*p) < 81 ) {
+			if ( 73 <= (*p) && (*p) <= 78 )
+				goto tr0;
+		} else if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto tr0;
+		} else
+			goto tr0;
+	} else
+		goto tr0;
 	goto st0;
 st0:
 cs = 0;
 	goto _out;
 tr0:
-#line 82 "parser.rl"
+#line 87 "parser.rl"
 	{
     token_begin = p;
 }
 	goto st2;
 st2:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof2;
 case 2:
-#line 76 "parser.c"
-	if ( (*p) == 79 )
-		goto st3;
-	goto st0;
-st3:
-	p += 1;
-case 3:
-	if ( (*p) == 78 )
-		goto st4;
-	goto st0;
-st4:
-	p += 1;
-case 4:
-	if ( (*p) == 78 )
-		goto st5;
-	goto st0;
-st5:
-	p += 1;
-case 5:
-	if ( (*p) == 69 )
-		goto st6;
-	goto st0;
-st6:
-	p += 1;
-case 6:
-	if ( (*p) == 67 )
-		goto st7;
-	goto st0;
-st7:
-	p += 1;
-case 7:
-	if ( (*p) == 84 )
-		goto st8;
-	goto st0;
-st8:
-	p += 1;
-case 8:
-	if ( (*p) == 32 )
-		goto tr14;
-	if ( 9 <= (*p) && (*p) <= 13 )
-		goto tr14;
+#line 129 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
-tr14:
-#line 86 "parser.rl"
+tr8:
+#line 136 "parser.rl"
 	{
     token_end = p;
-    try
-    {
-        request.method = method_from(TOKEN_REF);
-    }
-    catch(...)
-    {
-        {p++; cs = 9; goto _out;}
-    }
+    request.method = Method::EXTENSION;
+    request.method_name = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st9;
-st9:
-	p += 1;
-case 9:
-#line 134 "parser.c"
+	goto st3;
+tr42:
+#line 91 "parser.rl"
+	{
+    request.method = Method::CONNECT;
+    token_begin = nullptr;
+}
+	goto st3;
+tr43:
+#line 96 "parser.rl"
+	{
+    request.method = Method::DELETE_;
+    token_begin = nullptr;
+}
+	goto st3;
+tr44:
+#line 101 "parser.rl"
+	{
+    request.method = Method::GET;
+    token_begin = nullptr;
+}
+	goto st3;
+tr45:
+#line 106 "parser.rl"
+	{
+    request.method = Method::HEAD;
+    token_begin = nullptr;
+}
+	goto st3;
+tr46:
+#line 111 "parser.rl"
+	{
+    request.method = Method::OPTIONS;
+    token_begin = nullptr;
+}
+	goto st3;
+tr47:
+#line 116 "parser.rl"
+	{
+    request.method = Method::PATCH;
+    token_begin = nullptr;
+}
+	goto st3;
+tr48:
+#line 121 "parser.rl"
+	{
+    request.method = Method::POST;
+    token_begin = nullptr;
+}
+	goto st3;
+tr49:
+#line 126 "parser.rl"
+	{
+    request.method = Method::PUT;
+    token_begin = nullptr;
+}
+	goto st3;
+tr50:
+#line 131 "parser.rl"
+	{
+    request.method = Method::TRACE;
+    token_begin = nullptr;
+}
+	goto st3;
+st3:
+	if ( ++p == pe )
+		goto _test_eof3;
+case 3:
+#line 229 "parser.c"
 	switch( (*p) ) {
 		case 32: goto st0;
 		case 63: goto st0;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
 		goto st0;
-	goto tr15;
-tr15:
+	goto tr9;
+tr9:
 #line 32 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st10;
-st10:
-	p += 1;
-case 10:
-#line 149 "parser.c"
+	goto st4;
+st4:
+	if ( ++p == pe )
+		goto _test_eof4;
+case 4:
+#line 247 "parser.c"
 	switch( (*p) ) {
-		case 32: goto tr17;
-		case 63: goto tr18;
+		case 32: goto tr10;
+		case 63: goto tr11;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto tr17;
-	goto st10;
-tr17:
+		goto tr10;
+	goto st4;
+tr10:
 #line 36 "parser.rl"
 	{
     token_end = p;
     request.uri = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st11;
-tr58:
-#line 62 "parser.rl"
+	goto st5;
+tr31:
+#line 67 "parser.rl"
 	{
     token_begin = p;
 }
-#line 66 "parser.rl"
+#line 71 "parser.rl"
 	{
     token_end = p;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
-	goto st11;
-tr62:
-#line 66 "parser.rl"
+	goto st5;
+tr34:
+#line 71 "parser.rl"
 	{
     token_end = p;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
-	goto st11;
-tr66:
-#line 72 "parser.rl"
+	goto st5;
+tr38:
+#line 77 "parser.rl"
 	{
     token_begin = p;
 }
-#line 76 "parser.rl"
+#line 81 "parser.rl"
 	{
     token_end = p;
     request.query_params.back().second = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st11;
-tr69:
-#line 76 "parser.rl"
+	goto st5;
+tr40:
+#line 81 "parser.rl"
 	{
     token_end = p;
     request.query_params.back().second = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st11;
-st11:
-	p += 1;
-case 11:
-#line 200 "parser.c"
+	goto st5;
+st5:
+	if ( ++p == pe )
+		goto _test_eof5;
+case 5:
+#line 307 "parser.c"
 	if ( (*p) == 72 )
-		goto st12;
+		goto st6;
 	goto st0;
-st12:
-	p += 1;
-case 12:
+st6:
+	if ( ++p == pe )
+		goto _test_eof6;
+case 6:
 	if ( (*p) == 84 )
-		goto st13;
+		goto st7;
 	goto st0;
-st13:
-	p += 1;
-case 13:
+st7:
+	if ( ++p == pe )
+		goto _test_eof7;
+case 7:
 	if ( (*p) == 84 )
-		goto st14;
+		goto st8;
 	goto st0;
-st14:
-	p += 1;
-case 14:
+st8:
+	if ( ++p == pe )
+		goto _test_eof8;
+case 8:
 	if ( (*p) == 80 )
-		goto st15;
+		goto st9;
 	goto st0;
-st15:
-	p += 1;
-case 15:
+st9:
+	if ( ++p == pe )
+		goto _test_eof9;
+case 9:
 	if ( (*p) == 47 )
-		goto st16;
+		goto st10;
 	goto st0;
-st16:
-	p += 1;
-case 16:
+st10:
+	if ( ++p == pe )
+		goto _test_eof10;
+case 10:
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr24;
+		goto tr12;
 	goto st0;
-tr24:
-#line 125 "parser.rl"
+tr12:
+#line 195 "parser.rl"
 	{ request.major = (*p) - '0';}
-	goto st17;
-st17:
-	p += 1;
-case 17:
-#line 239 "parser.c"
+	goto st11;
+st11:
+	if ( ++p == pe )
+		goto _test_eof11;
+case 11:
+#line 354 "parser.c"
 	if ( (*p) == 46 )
-		goto st18;
+		goto st12;
 	goto st0;
-st18:
-	p += 1;
-case 18:
+st12:
+	if ( ++p == pe )
+		goto _test_eof12;
+case 12:
 	if ( 48 <= (*p) && (*p) <= 57 )
-		goto tr26;
+		goto tr13;
 	goto st0;
-tr26:
-#line 126 "parser.rl"
+tr13:
+#line 196 "parser.rl"
 	{request.minor = (*p) - '0';}
-	goto st19;
-st19:
-	p += 1;
-case 19:
-#line 254 "parser.c"
+	goto st13;
+st13:
+	if ( ++p == pe )
+		goto _test_eof13;
+case 13:
+#line 373 "parser.c"
 	if ( (*p) == 13 )
-		goto st20;
+		goto st14;
 	goto st0;
-st20:
-	p += 1;
-case 20:
+st14:
+	if ( ++p == pe )
+		goto _test_eof14;
+case 14:
 	if ( (*p) == 10 )
-		goto st21;
+		goto st15;
 	goto st0;
-st21:
-	p += 1;
-case 21:
+st15:
+	if ( ++p == pe )
+		goto _test_eof15;
+case 15:
 	switch( (*p) ) {
-		case 13: goto st22;
-		case 45: goto tr30;
+		case 13: goto st16;
+		case 45: goto tr14;
 	}
 	if ( (*p) < 65 ) {
 		if ( 48 <= (*p) && (*p) <= 57 )
-			goto tr30;
+			goto tr14;
 	} else if ( (*p) > 90 ) {
 		if ( 97 <= (*p) && (*p) <= 122 )
-			goto tr30;
+			goto tr14;
 	} else
-		goto tr30;
+		goto tr14;
 	goto st0;
-st22:
-	p += 1;
-case 22:
+st16:
+	if ( ++p == pe )
+		goto _test_eof16;
+case 16:
 	if ( (*p) == 10 )
-		goto st61;
+		goto st77;
 	goto st0;
-st61:
-#line 134 "parser.rl"
+st77:
+#line 204 "parser.rl"
 	{
-                    {p++; cs = 61; goto _out;}
+                    {p++; cs = 77; goto _out;}
                 }
-	p += 1;
-case 61:
-#line 291 "parser.c"
+	if ( ++p == pe )
+		goto _test_eof77;
+case 77:
+#line 416 "parser.c"
 	goto st0;
-tr30:
+tr14:
 #line 42 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st23;
-st23:
-	p += 1;
-case 23:
-#line 300 "parser.c"
+	goto st17;
+st17:
+	if ( ++p == pe )
+		goto _test_eof17;
+case 17:
+#line 428 "parser.c"
 	switch( (*p) ) {
-		case 32: goto tr32;
-		case 45: goto st23;
-		case 58: goto tr34;
+		case 32: goto tr15;
+		case 45: goto st17;
+		case 58: goto tr16;
 	}
 	if ( (*p) < 48 ) {
 		if ( 9 <= (*p) && (*p) <= 13 )
-			goto tr32;
+			goto tr15;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 97 <= (*p) && (*p) <= 122 )
-				goto st23;
+				goto st17;
 		} else if ( (*p) >= 65 )
-			goto st23;
+			goto st17;
 	} else
-		goto st23;
+		goto st17;
 	goto st0;
-tr32:
+tr15:
 #line 46 "parser.rl"
 	{
     token_end = p;
-    request.headers.emplace_back(TOKEN_REF, "");
+    request.addHeader(TOKEN_REF);
     token_begin = token_end = nullptr;
 }
-	goto st24;
-st24:
-	p += 1;
-case 24:
-#line 327 "parser.c"
+	goto st18;
+st18:
+	if ( ++p == pe )
+		goto _test_eof18;
+case 18:
+#line 458 "parser.c"
 	switch( (*p) ) {
-		case 32: goto st24;
-		case 58: goto st25;
+		case 32: goto st18;
+		case 58: goto st19;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto st24;
+		goto st18;
 	goto st0;
-tr34:
+tr16:
 #line 46 "parser.rl"
 	{
     token_end = p;
-    request.headers.emplace_back(TOKEN_REF, "");
+    request.addHeader(TOKEN_REF);
     token_begin = token_end = nullptr;
 }
-	goto st25;
-st25:
-	p += 1;
-case 25:
-#line 344 "parser.c"
+	goto st19;
+st19:
+	if ( ++p == pe )
+		goto _test_eof19;
+case 19:
+#line 478 "parser.c"
 	switch( (*p) ) {
-		case 13: goto tr39;
-		case 32: goto tr38;
+		case 13: goto tr19;
+		case 32: goto tr18;
 	}
 	if ( 9 <= (*p) && (*p) <= 12 )
-		goto tr38;
-	goto tr37;
-tr37:
+		goto tr18;
+	goto tr17;
+tr17:
 #line 52 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st26;
-st26:
-	p += 1;
-case 26:
-#line 359 "parser.c"
+	goto st20;
+st20:
+	if ( ++p == pe )
+		goto _test_eof20;
+case 20:
+#line 496 "parser.c"
 	if ( (*p) == 13 )
-		goto tr41;
-	goto st26;
-tr41:
+		goto tr20;
+	goto st20;
+tr20:
 #line 56 "parser.rl"
 	{
     token_end = p;
-    request.headers.back().second = TOKEN_REF;
+    bool valid = request.setHeaderValue(TOKEN_REF);
     token_begin = token_end = nullptr;
+    if (!valid)
+    {
+        cs = http_error;
+        goto _out;
+    }
 }
-	goto st27;
-st27:
-	p += 1;
-case 27:
-#line 372 "parser.c"
+	goto st21;
+st21:
+	if ( ++p == pe )
+		goto _test_eof21;
+case 21:
+#line 517 "parser.c"
 	switch( (*p) ) {
-		case 10: goto st21;
-		case 13: goto tr41;
+		case 10: goto st15;
+		case 13: goto tr20;
 	}
-	goto st26;
-tr50:
+	goto st20;
+tr18:
+#line 52 "parser.rl"
+	{
+    token_begin = p;
+}
+	goto st22;
+tr28:
 #line 46 "parser.rl"
 	{
     token_end = p;
-    request.headers.emplace_back(TOKEN_REF, "");
+    request.addHeader(TOKEN_REF);
     token_begin = token_end = nullptr;
 }
-	goto st28;
-tr38:
-#line 52 "parser.rl"
-	{
-    token_begin = p;
-}
-	goto st28;
-st28:
-	p += 1;
-case 28:
-#line 392 "parser.c"
+	goto st22;
+st22:
+	if ( ++p == pe )
+		goto _test_eof22;
+case 22:
+#line 541 "parser.c"
 	switch( (*p) ) {
-		case 13: goto tr42;
-		case 32: goto tr38;
+		case 13: goto tr21;
+		case 32: goto tr18;
 	}
 	if ( 9 <= (*p) && (*p) <= 12 )
-		goto tr38;
-	goto tr37;
-tr39:
+		goto tr18;
+	goto tr17;
+tr19:
 #line 52 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st29;
-tr42:
+	goto st23;
+tr21:
 #line 52 "parser.rl"
 	{
     token_begin = p;
@@ -454,50 +559,57 @@ tr42:
 #line 56 "parser.rl"
 	{
     token_end = p;
-    request.headers.back().second = TOKEN_REF;
+    bool valid = request.setHeaderValue(TOKEN_REF);
     token_begin = token_end = nullptr;
+    if (!valid)
+    {
+        cs = http_error;
+        goto _out;
+    }
 }
-	goto st29;
-st29:
-	p += 1;
-case 29:
-#line 417 "parser.c"
+	goto st23;
+st23:
+	if ( ++p == pe )
+		goto _test_eof23;
+case 23:
+#line 576 "parser.c"
 	switch( (*p) ) {
-		case 10: goto tr43;
-		case 13: goto tr42;
-		case 32: goto tr38;
+		case 10: goto tr22;
+		case 13: goto tr21;
+		case 32: goto tr18;
 	}
 	if ( 9 <= (*p) && (*p) <= 12 )
-		goto tr38;
-	goto tr37;
-tr43:
+		goto tr18;
+	goto tr17;
+tr22:
 #line 52 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st30;
-st30:
-	p += 1;
-case 30:
-#line 433 "parser.c"
+	goto st24;
+st24:
+	if ( ++p == pe )
+		goto _test_eof24;
+case 24:
+#line 595 "parser.c"
 	switch( (*p) ) {
-		case 13: goto tr44;
-		case 32: goto tr38;
-		case 45: goto tr45;
+		case 13: goto tr23;
+		case 32: goto tr18;
+		case 45: goto tr24;
 	}
 	if ( (*p) < 48 ) {
 		if ( 9 <= (*p) && (*p) <= 12 )
-			goto tr38;
+			goto tr18;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 97 <= (*p) && (*p) <= 122 )
-				goto tr45;
+				goto tr24;
 		} else if ( (*p) >= 65 )
-			goto tr45;
+			goto tr24;
 	} else
-		goto tr45;
-	goto tr37;
-tr44:
+		goto tr24;
+	goto tr17;
+tr23:
 #line 52 "parser.rl"
 	{
     token_begin = p;
@@ -505,54 +617,61 @@ tr44:
 #line 56 "parser.rl"
 	{
     token_end = p;
-    request.headers.back().second = TOKEN_REF;
+    bool valid = request.setHeaderValue(TOKEN_REF);
     token_begin = token_end = nullptr;
+    if (!valid)
+    {
+        cs = http_error;
+        goto _out;
+    }
 }
-	goto st31;
-st31:
-	p += 1;
-case 31:
-#line 463 "parser.c"
+	goto st25;
+st25:
+	if ( ++p == pe )
+		goto _test_eof25;
+case 25:
+#line 634 "parser.c"
 	switch( (*p) ) {
-		case 10: goto tr46;
-		case 13: goto tr42;
-		case 32: goto tr38;
+		case 10: goto tr25;
+		case 13: goto tr21;
+		case 32: goto tr18;
 	}
 	if ( 9 <= (*p) && (*p) <= 12 )
-		goto tr38;
-	goto tr37;
-tr46:
+		goto tr18;
+	goto tr17;
+tr25:
 #line 52 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st62;
-st62:
-#line 134 "parser.rl"
+	goto st78;
+st78:
+#line 204 "parser.rl"
 	{
-                    {p++; cs = 62; goto _out;}
+                    {p++; cs = 78; goto _out;}
                 }
-	p += 1;
-case 62:
-#line 482 "parser.c"
+	if ( ++p == pe )
+		goto _test_eof78;
+case 78:
+#line 657 "parser.c"
 	switch( (*p) ) {
-		case 13: goto tr44;
-		case 32: goto tr38;
-		case 45: goto tr45;
+		case 13: goto tr23;
+		case 32: goto tr18;
+		case 45: goto tr24;
 	}
 	if ( (*p) < 48 ) {
 		if ( 9 <= (*p) && (*p) <= 12 )
-			goto tr38;
+			goto tr18;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 97 <= (*p) && (*p) <= 122 )
-				goto tr45;
+				goto tr24;
 		} else if ( (*p) >= 65 )
-			goto tr45;
+			goto tr24;
 	} else
-		goto tr45;
-	goto tr37;
-tr45:
+		goto tr24;
+	goto tr17;
+tr24:
 #line 52 "parser.rl"
 	{
     token_begin = p;
@@ -561,436 +680,1612 @@ tr45:
 	{
     token_begin = p;
 }
-	goto st32;
-st32:
-	p += 1;
-case 32:
-#line 510 "parser.c"
+	goto st26;
+st26:
+	if ( ++p == pe )
+		goto _test_eof26;
+case 26:
+#line 689 "parser.c"
 	switch( (*p) ) {
-		case 13: goto tr48;
-		case 32: goto tr47;
-		case 45: goto st32;
-		case 58: goto tr50;
+		case 13: goto tr27;
+		case 32: goto tr26;
+		case 45: goto st26;
+		case 58: goto tr28;
 	}
 	if ( (*p) < 48 ) {
 		if ( 9 <= (*p) && (*p) <= 12 )
-			goto tr47;
+			goto tr26;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 97 <= (*p) && (*p) <= 122 )
-				goto st32;
+				goto st26;
 		} else if ( (*p) >= 65 )
-			goto st32;
+			goto st26;
 	} else
-		goto st32;
-	goto st26;
-tr47:
+		goto st26;
+	goto st20;
+tr26:
 #line 46 "parser.rl"
 	{
     token_end = p;
-    request.headers.emplace_back(TOKEN_REF, "");
+    request.addHeader(TOKEN_REF);
     token_begin = token_end = nullptr;
 }
-	goto st33;
-st33:
-	p += 1;
-case 33:
-#line 538 "parser.c"
+	goto st27;
+st27:
+	if ( ++p == pe )
+		goto _test_eof27;
+case 27:
+#line 720 "parser.c"
 	switch( (*p) ) {
-		case 13: goto tr52;
-		case 32: goto st33;
-		case 58: goto st28;
+		case 13: goto tr29;
+		case 32: goto st27;
+		case 58: goto st22;
 	}
 	if ( 9 <= (*p) && (*p) <= 12 )
-		goto st33;
-	goto st26;
-tr52:
-#line 56 "parser.rl"
+		goto st27;
+	goto st20;
+tr27:
+#line 46 "parser.rl"
 	{
     token_end = p;
-    request.headers.back().second = TOKEN_REF;
+    request.addHeader(TOKEN_REF);
     token_begin = token_end = nullptr;
 }
-	goto st34;
-tr48:
-#line 46 "parser.rl"
+#line 56 "parser.rl"
 	{
     token_end = p;
-    request.headers.emplace_back(TOKEN_REF, "");
+    bool valid = request.setHeaderValue(TOKEN_REF);
     token_begin = token_end = nullptr;
+    if (!valid)
+    {
+        cs = http_error;
+        goto _out;
+    }
 }
+	goto st28;
+tr29:
 #line 56 "parser.rl"
 	{
     token_end = p;
-    request.headers.back().second = TOKEN_REF;
+    bool valid = request.setHeaderValue(TOKEN_REF);
     token_begin = token_end = nullptr;
+    if (!valid)
+    {
+        cs = http_error;
+        goto _out;
+    }
 }
-	goto st34;
-st34:
-	p += 1;
-case 34:
-#line 568 "parser.c"
+	goto st28;
+st28:
+	if ( ++p == pe )
+		goto _test_eof28;
+case 28:
+#line 765 "parser.c"
 	switch( (*p) ) {
-		case 10: goto st35;
-		case 13: goto tr52;
-		case 32: goto st33;
-		case 58: goto st28;
+		case 10: goto st29;
+		case 13: goto tr29;
+		case 32: goto st27;
+		case 58: goto st22;
 	}
 	if ( 9 <= (*p) && (*p) <= 12 )
-		goto st33;
-	goto st26;
-st35:
-	p += 1;
-case 35:
+		goto st27;
+	goto st20;
+st29:
+	if ( ++p == pe )
+		goto _test_eof29;
+case 29:
 	switch( (*p) ) {
-		case 13: goto st36;
-		case 32: goto st24;
-		case 45: goto tr30;
-		case 58: goto st25;
+		case 13: goto st30;
+		case 32: goto st18;
+		case 45: goto tr14;
+		case 58: goto st19;
 	}
 	if ( (*p) < 48 ) {
 		if ( 9 <= (*p) && (*p) <= 12 )
-			goto st24;
+			goto st18;
 	} else if ( (*p) > 57 ) {
 		if ( (*p) > 90 ) {
 			if ( 97 <= (*p) && (*p) <= 122 )
-				goto tr30;
+				goto tr14;
 		} else if ( (*p) >= 65 )
-			goto tr30;
+			goto tr14;
 	} else
-		goto tr30;
+		goto tr14;
 	goto st0;
-st36:
-	p += 1;
-case 36:
+st30:
+	if ( ++p == pe )
+		goto _test_eof30;
+case 30:
 	switch( (*p) ) {
-		case 10: goto st63;
-		case 32: goto st24;
-		case 58: goto st25;
+		case 10: goto st79;
+		case 32: goto st18;
+		case 58: goto st19;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto st24;
+		goto st18;
 	goto st0;
-st63:
-#line 134 "parser.rl"
+st79:
+#line 204 "parser.rl"
 	{
-                    {p++; cs = 63; goto _out;}
+                    {p++; cs = 79; goto _out;}
                 }
-	p += 1;
-case 63:
-#line 615 "parser.c"
+	if ( ++p == pe )
+		goto _test_eof79;
+case 79:
+#line 817 "parser.c"
 	switch( (*p) ) {
-		case 32: goto st24;
-		case 58: goto st25;
+		case 32: goto st18;
+		case 58: goto st19;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto st24;
+		goto st18;
 	goto st0;
-tr18:
+tr11:
 #line 36 "parser.rl"
 	{
     token_end = p;
     request.uri = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st37;
-tr59:
-#line 62 "parser.rl"
+	goto st31;
+tr32:
+#line 67 "parser.rl"
 	{
     token_begin = p;
 }
-#line 66 "parser.rl"
+#line 71 "parser.rl"
 	{
     token_end = p;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
-	goto st37;
-tr63:
-#line 66 "parser.rl"
+	goto st31;
+tr35:
+#line 71 "parser.rl"
 	{
     token_end = p;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
-	goto st37;
-tr67:
-#line 72 "parser.rl"
+	goto st31;
+tr39:
+#line 77 "parser.rl"
 	{
     token_begin = p;
 }
-#line 76 "parser.rl"
+#line 81 "parser.rl"
 	{
     token_end = p;
     request.query_params.back().second = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st37;
-tr70:
-#line 76 "parser.rl"
+	goto st31;
+tr41:
+#line 81 "parser.rl"
 	{
     token_end = p;
     request.query_params.back().second = TOKEN_REF;
     token_begin = token_end = nullptr;
 }
-	goto st37;
-st37:
-	p += 1;
-case 37:
-#line 666 "parser.c"
+	goto st31;
+st31:
+	if ( ++p == pe )
+		goto _test_eof31;
+case 31:
+#line 877 "parser.c"
 	switch( (*p) ) {
-		case 32: goto tr58;
-		case 38: goto tr59;
-		case 61: goto tr60;
+		case 32: goto tr31;
+		case 38: goto tr32;
+		case 61: goto tr33;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto tr58;
-	goto tr57;
-tr57:
-#line 62 "parser.rl"
+		goto tr31;
+	goto tr30;
+tr30:
+#line 67 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st38;
-st38:
-	p += 1;
-case 38:
-#line 682 "parser.c"
+	goto st32;
+st32:
+	if ( ++p == pe )
+		goto _test_eof32;
+case 32:
+#line 896 "parser.c"
 	switch( (*p) ) {
-		case 32: goto tr62;
-		case 38: goto tr63;
-		case 61: goto tr64;
+		case 32: goto tr34;
+		case 38: goto tr35;
+		case 61: goto tr36;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto tr62;
-	goto st38;
-tr60:
-#line 62 "parser.rl"
+		goto tr34;
+	goto st32;
+tr33:
+#line 67 "parser.rl"
 	{
     token_begin = p;
 }
-#line 66 "parser.rl"
+#line 71 "parser.rl"
 	{
     token_end = p;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
-	goto st39;
-tr64:
-#line 66 "parser.rl"
+	goto st33;
+tr36:
+#line 71 "parser.rl"
 	{
     token_end = p;
-    request.query_params.emplace_back(UTILS::url_decode(token_begin, token_end), "");
+    request.query_params.emplace_back(TOKEN_REF, "");
     token_begin = token_end = nullptr;
 }
-	goto st39;
-st39:
-	p += 1;
-case 39:
-#line 710 "parser.c"
+	goto st33;
+st33:
+	if ( ++p == pe )
+		goto _test_eof33;
+case 33:
+#line 929 "parser.c"
 	switch( (*p) ) {
-		case 32: goto tr66;
-		case 38: goto tr67;
+		case 32: goto tr38;
+		case 38: goto tr39;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto tr66;
-	goto tr65;
-tr65:
-#line 72 "parser.rl"
+		goto tr38;
+	goto tr37;
+tr37:
+#line 77 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st40;
-st40:
-	p += 1;
-case 40:
-#line 725 "parser.c"
+	goto st34;
+st34:
+	if ( ++p == pe )
+		goto _test_eof34;
+case 34:
+#line 947 "parser.c"
 	switch( (*p) ) {
-		case 32: goto tr69;
-		case 38: goto tr70;
+		case 32: goto tr40;
+		case 38: goto tr41;
 	}
 	if ( 9 <= (*p) && (*p) <= 13 )
-		goto tr69;
-	goto st40;
-tr2:
-#line 82 "parser.rl"
+		goto tr40;
+	goto st34;
+tr1:
+#line 87 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st41;
+	goto st35;
+st35:
+	if ( ++p == pe )
+		goto _test_eof35;
+case 35:
+#line 965 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 79: goto st36;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st36:
+	if ( ++p == pe )
+		goto _test_eof36;
+case 36:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 78: goto st37;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st37:
+	if ( ++p == pe )
+		goto _test_eof37;
+case 37:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 78: goto st38;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st38:
+	if ( ++p == pe )
+		goto _test_eof38;
+case 38:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st39;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st39:
+	if ( ++p == pe )
+		goto _test_eof39;
+case 39:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 67: goto st40;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st40:
+	if ( ++p == pe )
+		goto _test_eof40;
+case 40:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st41;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
 st41:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof41;
 case 41:
-#line 740 "parser.c"
-	if ( (*p) == 69 )
-		goto st42;
+	switch( (*p) ) {
+		case 32: goto tr42;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr42;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
+tr2:
+#line 87 "parser.rl"
+	{
+    token_begin = p;
+}
+	goto st42;
 st42:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof42;
 case 42:
-	if ( (*p) == 76 )
-		goto st43;
+#line 1167 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st43;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st43:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof43;
 case 43:
-	if ( (*p) == 69 )
-		goto st44;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 76: goto st44;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st44:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof44;
 case 44:
-	if ( (*p) == 84 )
-		goto st45;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st45;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st45:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof45;
 case 45:
-	if ( (*p) == 69 )
-		goto st8;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st46;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
-tr3:
-#line 82 "parser.rl"
-	{
-    token_begin = p;
-}
-	goto st46;
 st46:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof46;
 case 46:
-#line 775 "parser.c"
-	if ( (*p) == 69 )
-		goto st7;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st47;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
-tr4:
-#line 82 "parser.rl"
-	{
-    token_begin = p;
-}
-	goto st47;
 st47:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof47;
 case 47:
-#line 786 "parser.c"
-	if ( (*p) == 69 )
-		goto st48;
+	switch( (*p) ) {
+		case 32: goto tr43;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr43;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
+tr3:
+#line 87 "parser.rl"
+	{
+    token_begin = p;
+}
+	goto st48;
 st48:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof48;
 case 48:
-	if ( (*p) == 65 )
-		goto st49;
+#line 1341 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st49;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st49:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof49;
 case 49:
-	if ( (*p) == 68 )
-		goto st8;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st50;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
-tr5:
-#line 82 "parser.rl"
-	{
-    token_begin = p;
-}
-	goto st50;
 st50:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof50;
 case 50:
-#line 809 "parser.c"
-	if ( (*p) == 80 )
-		goto st51;
+	switch( (*p) ) {
+		case 32: goto tr44;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr44;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
+tr4:
+#line 87 "parser.rl"
+	{
+    token_begin = p;
+}
+	goto st51;
 st51:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof51;
 case 51:
-	if ( (*p) == 84 )
-		goto st52;
+#line 1431 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st52;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st52:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof52;
 case 52:
-	if ( (*p) == 73 )
-		goto st53;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 65: goto st53;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 66 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st53:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof53;
 case 53:
-	if ( (*p) == 79 )
-		goto st54;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 68: goto st54;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st54:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof54;
 case 54:
-	if ( (*p) == 78 )
-		goto st55;
-	goto st0;
-st55:
-	p += 1;
-case 55:
-	if ( (*p) == 83 )
-		goto st8;
+	switch( (*p) ) {
+		case 32: goto tr45;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr45;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
-tr6:
-#line 82 "parser.rl"
+tr5:
+#line 87 "parser.rl"
 	{
     token_begin = p;
 }
-	goto st56;
+	goto st55;
+st55:
+	if ( ++p == pe )
+		goto _test_eof55;
+case 55:
+#line 1549 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 80: goto st56;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
 st56:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof56;
 case 56:
-#line 850 "parser.c"
 	switch( (*p) ) {
-		case 79: goto st57;
-		case 85: goto st7;
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st57;
+		case 123: goto st0;
+		case 125: goto st0;
 	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st57:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof57;
 case 57:
-	if ( (*p) == 83 )
-		goto st7;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 73: goto st58;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
-tr7:
-#line 82 "parser.rl"
-	{
-    token_begin = p;
-}
-	goto st58;
 st58:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof58;
 case 58:
-#line 869 "parser.c"
-	if ( (*p) == 82 )
-		goto st59;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 79: goto st59;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st59:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof59;
 case 59:
-	if ( (*p) == 65 )
-		goto st60;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 78: goto st60;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
 st60:
-	p += 1;
+	if ( ++p == pe )
+		goto _test_eof60;
 case 60:
-	if ( (*p) == 67 )
-		goto st45;
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 83: goto st61;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
 	goto st0;
+st61:
+	if ( ++p == pe )
+		goto _test_eof61;
+case 61:
+	switch( (*p) ) {
+		case 32: goto tr46;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr46;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+tr6:
+#line 87 "parser.rl"
+	{
+    token_begin = p;
+}
+	goto st62;
+st62:
+	if ( ++p == pe )
+		goto _test_eof62;
+case 62:
+#line 1751 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 65: goto st63;
+		case 79: goto st67;
+		case 85: goto st70;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 66 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st63:
+	if ( ++p == pe )
+		goto _test_eof63;
+case 63:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st64;
+		case 123: goto st0;
+		case 125: goto st0;
 	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st64:
+	if ( ++p == pe )
+		goto _test_eof64;
+case 64:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 67: goto st65;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st65:
+	if ( ++p == pe )
+		goto _test_eof65;
+case 65:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 72: goto st66;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st66:
+	if ( ++p == pe )
+		goto _test_eof66;
+case 66:
+	switch( (*p) ) {
+		case 32: goto tr47;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr47;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st67:
+	if ( ++p == pe )
+		goto _test_eof67;
+case 67:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 83: goto st68;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st68:
+	if ( ++p == pe )
+		goto _test_eof68;
+case 68:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st69;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st69:
+	if ( ++p == pe )
+		goto _test_eof69;
+case 69:
+	switch( (*p) ) {
+		case 32: goto tr48;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr48;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st70:
+	if ( ++p == pe )
+		goto _test_eof70;
+case 70:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 84: goto st71;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st71:
+	if ( ++p == pe )
+		goto _test_eof71;
+case 71:
+	switch( (*p) ) {
+		case 32: goto tr49;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr49;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+tr7:
+#line 87 "parser.rl"
+	{
+    token_begin = p;
+}
+	goto st72;
+st72:
+	if ( ++p == pe )
+		goto _test_eof72;
+case 72:
+#line 2037 "parser.c"
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 82: goto st73;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st73:
+	if ( ++p == pe )
+		goto _test_eof73;
+case 73:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 65: goto st74;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 66 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st74:
+	if ( ++p == pe )
+		goto _test_eof74;
+case 74:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 67: goto st75;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st75:
+	if ( ++p == pe )
+		goto _test_eof75;
+case 75:
+	switch( (*p) ) {
+		case 32: goto tr8;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 69: goto st76;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr8;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+st76:
+	if ( ++p == pe )
+		goto _test_eof76;
+case 76:
+	switch( (*p) ) {
+		case 32: goto tr50;
+		case 34: goto st0;
+		case 44: goto st0;
+		case 47: goto st0;
+		case 123: goto st0;
+		case 125: goto st0;
+	}
+	if ( (*p) < 42 ) {
+		if ( (*p) > 13 ) {
+			if ( 33 <= (*p) && (*p) <= 39 )
+				goto st2;
+		} else if ( (*p) >= 9 )
+			goto tr50;
+	} else if ( (*p) > 57 ) {
+		if ( (*p) > 90 ) {
+			if ( 94 <= (*p) && (*p) <= 126 )
+				goto st2;
+		} else if ( (*p) >= 65 )
+			goto st2;
+	} else
+		goto st2;
+	goto st0;
+	}
+	_test_eof2: cs = 2; goto _test_eof; 
+	_test_eof3: cs = 3; goto _test_eof; 
+	_test_eof4: cs = 4; goto _test_eof; 
+	_test_eof5: cs = 5; goto _test_eof; 
+	_test_eof6: cs = 6; goto _test_eof; 
+	_test_eof7: cs = 7; goto _test_eof; 
+	_test_eof8: cs = 8; goto _test_eof; 
+	_test_eof9: cs = 9; goto _test_eof; 
+	_test_eof10: cs = 10; goto _test_eof; 
+	_test_eof11: cs = 11; goto _test_eof; 
+	_test_eof12: cs = 12; goto _test_eof; 
+	_test_eof13: cs = 13; goto _test_eof; 
+	_test_eof14: cs = 14; goto _test_eof; 
+	_test_eof15: cs = 15; goto _test_eof; 
+	_test_eof16: cs = 16; goto _test_eof; 
+	_test_eof17: cs = 17; goto _test_eof; 
+	_test_eof18: cs = 18; goto _test_eof; 
+	_test_eof19: cs = 19; goto _test_eof; 
+	_test_eof20: cs = 20; goto _test_eof; 
+	_test_eof21: cs = 21; goto _test_eof; 
+	_test_eof22: cs = 22; goto _test_eof; 
+	_test_eof23: cs = 23; goto _test_eof; 
+	_test_eof24: cs = 24; goto _test_eof; 
+	_test_eof25: cs = 25; goto _test_eof; 
+	_test_eof26: cs = 26; goto _test_eof; 
+	_test_eof27: cs = 27; goto _test_eof; 
+	_test_eof28: cs = 28; goto _test_eof; 
+	_test_eof29: cs = 29; goto _test_eof; 
+	_test_eof30: cs = 30; goto _test_eof; 
+	_test_eof31: cs = 31; goto _test_eof; 
+	_test_eof32: cs = 32; goto _test_eof; 
+	_test_eof33: cs = 33; goto _test_eof; 
+	_test_eof34: cs = 34; goto _test_eof; 
+	_test_eof35: cs = 35; goto _test_eof; 
+	_test_eof36: cs = 36; goto _test_eof; 
+	_test_eof37: cs = 37; goto _test_eof; 
+	_test_eof38: cs = 38; goto _test_eof; 
+	_test_eof39: cs = 39; goto _test_eof; 
+	_test_eof40: cs = 40; goto _test_eof; 
+	_test_eof41: cs = 41; goto _test_eof; 
+	_test_eof42: cs = 42; goto _test_eof; 
+	_test_eof43: cs = 43; goto _test_eof; 
+	_test_eof44: cs = 44; goto _test_eof; 
+	_test_eof45: cs = 45; goto _test_eof; 
+	_test_eof46: cs = 46; goto _test_eof; 
+	_test_eof47: cs = 47; goto _test_eof; 
+	_test_eof48: cs = 48; goto _test_eof; 
+	_test_eof49: cs = 49; goto _test_eof; 
+	_test_eof50: cs = 50; goto _test_eof; 
+	_test_eof51: cs = 51; goto _test_eof; 
+	_test_eof52: cs = 52; goto _test_eof; 
+	_test_eof53: cs = 53; goto _test_eof; 
+	_test_eof54: cs = 54; goto _test_eof; 
+	_test_eof55: cs = 55; goto _test_eof; 
+	_test_eof56: cs = 56; goto _test_eof; 
+	_test_eof57: cs = 57; goto _test_eof; 
+	_test_eof58: cs = 58; goto _test_eof; 
+	_test_eof59: cs = 59; goto _test_eof; 
+	_test_eof60: cs = 60; goto _test_eof; 
+	_test_eof61: cs = 61; goto _test_eof; 
+	_test_eof62: cs = 62; goto _test_eof; 
+	_test_eof63: cs = 63; goto _test_eof; 
+	_test_eof64: cs = 64; goto _test_eof; 
+	_test_eof65: cs = 65; goto _test_eof; 
+	_test_eof66: cs = 66; goto _test_eof; 
+	_test_eof67: cs = 67; goto _test_eof; 
+	_test_eof68: cs = 68; goto _test_eof; 
+	_test_eof69: cs = 69; goto _test_eof; 
+	_test_eof70: cs = 70; goto _test_eof; 
+	_test_eof71: cs = 71; goto _test_eof; 
+	_test_eof72: cs = 72; goto _test_eof; 
+	_test_eof73: cs = 73; goto _test_eof; 
+	_test_eof74: cs = 74; goto _test_eof; 
+	_test_eof75: cs = 75; goto _test_eof; 
+	_test_eof76: cs = 76; goto _test_eof; 
+	_test_eof77: cs = 77; goto _test_eof; 
+	_test_eof78: cs = 78; goto _test_eof; 
+	_test_eof79: cs = 79; goto _test_eof; 
 
+	_test_eof: {}
 	_out: {}
 	}
 
-#line 140 "parser.rl"
+#line 209 "parser.rl"
 
 
-    if (cs < http_first_final)
+    state.cs = cs;
+    state.offset = p - buffer;
+    state.token_begin = token_begin ? token_begin - buffer : State::NO_TOKEN;
+
+    if (cs == http_error)
+    {
+        return Result::Error;
+    }
+
+    if (cs >= http_first_final)
+    {
+        return Result::Complete;
+    }
+
+    return Result::Incomplete;
+}
+
+bool Parser::parse(const char* start,
+                   const char* end,
+                   size_t& consumed,
+                   Request& request)
+{
+    State state;
+    if (parse(state, start, end - start, request) != Result::Complete)
     {
-        GLOG(error) << "Invalid request read, cannot parse: " << std::string(p, end);
+        GLOG(error) << "Invalid request read, cannot parse: " << std::string(start, end);
         return false;
     }
 
-    consumed = p - start;
+    consumed = state.offset;
     return true;
 }
 
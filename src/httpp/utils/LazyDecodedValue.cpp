@@ -30,9 +30,14 @@ LazyDecodedValue::LazyDecodedValue(const char* str, size_t len)
 {
 }
 
-bool LazyDecodedValue::operator==(const LazyDecodedValue& rhs) const noexcept
+bool LazyDecodedValue::operator==(const LazyDecodedValue& rhs) const
 {
-    return raw_value_ == rhs.raw_value_;
+    return view() == rhs.view();
+}
+
+bool LazyDecodedValue::operator<(const LazyDecodedValue& rhs) const
+{
+    return view() < rhs.view();
 }
 
 LazyDecodedValue::operator const std::string&() const
@@ -42,9 +47,35 @@ LazyDecodedValue::operator const std::string&() const
 
 const std::string& LazyDecodedValue::string() const
 {
-    if (decoded_value_.empty())
+    view();
+    if (decoding_ == Decoding::NotNeeded)
+    {
+        decoded_value_ = raw_value_;
+        decoding_ = Decoding::Done;
+    }
+
+    return decoded_value_;
+}
+
+std::string_view LazyDecodedValue::view() const
+{
+    if (decoding_ == Decoding::Pending)
+    {
+        auto begin = raw_value_.data(), end = begin + raw_value_.size();
+        if (find_url_escape(begin, end) == end)
+        {
+            decoding_ = Decoding::NotNeeded;
+        }
+        else
+        {
+            url_decode(begin, end, decoded_value_);
+            decoding_ = Decoding::Done;
+        }
+    }
+
+    if (decoding_ == Decoding::NotNeeded)
     {
-        decoded_value_ = url_decode(raw_value_.data(), raw_value_.end());
+        return raw_value_;
     }
 
     return decoded_value_;
@@ -57,32 +88,32 @@ std::string_view LazyDecodedValue::raw() const noexcept
 
 std::string to_string(const LazyDecodedValue& val)
 {
-    return val.string();
+    return std::string(val.view());
 }
 
 bool operator==(const LazyDecodedValue& lhs, const char* rhs)
 {
-    return lhs.string() == rhs;
+    return lhs.view() == std::string_view(rhs);
 }
 
 bool operator==(const char* lhs, const LazyDecodedValue& rhs)
 {
-    return lhs == rhs.string();
+    return std::string_view(lhs) == rhs.view();
 }
 
 bool operator==(const LazyDecodedValue& lhs, std::string_view rhs)
 {
-    return lhs.string() == rhs;
+    return lhs.view() == rhs;
 }
 
 bool operator==(std::string_view lhs, const LazyDecodedValue& rhs)
 {
-    return lhs == rhs.string();
+    return lhs == rhs.view();
 }
 
 std::ostream& operator<<(std::ostream& os, const LazyDecodedValue& v)
 {
-    return os << v.string();
+    return os << v.view();
 }
 
 } // namespace UTILS
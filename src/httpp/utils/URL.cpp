@@ -0,0 +1,166 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include "httpp/utils/URL.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#elif defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
+namespace HTTPP
+{
+namespace UTILS
+{
+
+static inline bool is_escape(char c) noexcept
+{
+    return c == '%' || c == '+';
+}
+
+#if defined(__AVX2__)
+static const char* find_url_escape_simd(const char* p, const char* end) noexcept
+{
+    const auto percent = _mm256_set1_epi8('%');
+    const auto plus = _mm256_set1_epi8('+');
+    for (; p + 32 <= end; p += 32)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, percent), _mm256_cmpeq_epi8(block, plus))
+        );
+        if (mask)
+        {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return p;
+}
+#elif defined(__SSE2__)
+static const char* find_url_escape_simd(const char* p, const char* end) noexcept
+{
+    const auto percent = _mm_set1_epi8('%');
+    const auto plus = _mm_set1_epi8('+');
+    for (; p + 16 <= end; p += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, percent), _mm_cmpeq_epi8(block, plus))
+        );
+        if (mask)
+        {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return p;
+}
+#else
+static const char* find_url_escape_simd(const char* p, const char*) noexcept
+{
+    return p;
+}
+#endif
+
+// Eight bytes at a time, for the values shorter than a SIMD block and what
+// is left after it. Stops on the word that has an escape.
+static const char* find_url_escape_word(const char* p, const char* end) noexcept
+{
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    for (; p + 8 <= end; p += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        // A byte of these is zero where the word has the character
+        auto percent = word ^ (ones * '%');
+        auto plus = word ^ (ones * '+');
+        if ((((percent - ones) & ~percent) | ((plus - ones) & ~plus)) & highs)
+        {
+            break;
+        }
+    }
+    return p;
+}
+
+const char* find_url_escape(const char* begin, const char* end) noexcept
+{
+    auto p = find_url_escape_word(find_url_escape_simd(begin, end), end);
+
+    // The word loop stopped on it or there are less than 8 bytes left.
+    while (p != end && !is_escape(*p))
+    {
+        ++p;
+    }
+
+    return p;
+}
+
+static inline int hex_value(char c) noexcept
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+
+    return -1;
+}
+
+void url_decode(const char* begin, const char* end, std::string& out)
+{
+    // The decoded value is never longer than the raw one.
+    out.resize(end - begin);
+    char* o = &out[0];
+
+    // Runs without escape are copied in bulk, only the escapes are looked
+    // at one by one.
+    while (begin != end)
+    {
+        auto escape = find_url_escape(begin, end);
+        std::memcpy(o, begin, escape - begin);
+        o += escape - begin;
+        if (escape == end)
+        {
+            break;
+        }
+
+        begin = escape + 1;
+        if (*escape == '+')
+        {
+            *o++ = ' ';
+            continue;
+        }
+
+        int high, low;
+        if (end - begin >= 2 && (high = hex_value(begin[0])) >= 0 && (low = hex_value(begin[1])) >= 0)
+        {
+            *o++ = char(high << 4 | low);
+            begin += 2;
+        }
+        else
+        {
+            *o++ = '%';
+        }
+    }
+
+    out.resize(o - out.data());
+}
+
+} // namespace UTILS
+} // namespace HTTPP
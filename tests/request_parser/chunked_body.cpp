@@ -0,0 +1,107 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/http/helper/ChunkedDecoder.hpp"
+
+using HTTPP::HTTP::helper::ChunkedDecoder;
+
+static const std::string ENCODED =
+    "5\r\nhello\r\n"
+    "1;name=value\r\n \r\n"
+    "00a\r\nchunked wo\r\n"
+    "3 \r\nrld\r\n"
+    "0\r\n"
+    "Trailer: 1\r\n"
+    "\r\n"
+    "next request";
+
+static const size_t ENCODED_SIZE = ENCODED.size() - 12;
+
+// Feed encoded by pieces of step bytes, return the decoded payload.
+static ChunkedDecoder::Status decode(const std::string& encoded, size_t step, std::string& body, size_t& consumed)
+{
+    ChunkedDecoder decoder;
+    for (size_t offset = 0; offset < encoded.size(); offset += step)
+    {
+        const char* data = encoded.data() + offset;
+        const char* end = encoded.data() + std::min(offset + step, encoded.size());
+        std::string_view chunk;
+        for (;;)
+        {
+            auto status = decoder.decode(data, end, chunk);
+            if (status == ChunkedDecoder::Status::Data)
+            {
+                body.append(chunk.data(), chunk.size());
+                continue;
+            }
+
+            if (status != ChunkedDecoder::Status::NeedMore)
+            {
+                consumed = data - encoded.data();
+                return status;
+            }
+
+            break;
+        }
+    }
+
+    return ChunkedDecoder::Status::NeedMore;
+}
+
+BOOST_AUTO_TEST_CASE(split_anywhere)
+{
+    for (size_t step = 1; step <= ENCODED.size(); ++step)
+    {
+        std::string body;
+        size_t consumed = 0;
+        BOOST_REQUIRE(decode(ENCODED, step, body, consumed) == ChunkedDecoder::Status::Done);
+        BOOST_CHECK_EQUAL(body, "hello chunked world");
+        BOOST_CHECK_EQUAL(consumed, ENCODED_SIZE);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incomplete)
+{
+    std::string body;
+    size_t consumed = 0;
+    auto truncated = ENCODED.substr(0, ENCODED_SIZE - 1);
+    BOOST_CHECK(decode(truncated, 7, body, consumed) == ChunkedDecoder::Status::NeedMore);
+    BOOST_CHECK_EQUAL(body, "hello chunked world");
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+    for (std::string encoded :
+         {"x\r\n", "\r\n", "5\r\nhelloX\r\n", "5\n", "11111111111111111\r\n", "1\r\na\r\n0\r\n\rX"})
+    {
+        std::string body;
+        size_t consumed = 0;
+        BOOST_CHECK(decode(encoded, 1, body, consumed) == ChunkedDecoder::Status::Error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+    ChunkedDecoder decoder;
+    std::string encoded = "zz";
+    const char* data = encoded.data();
+    std::string_view chunk;
+    BOOST_CHECK(decoder.decode(data, data + encoded.size(), chunk) == ChunkedDecoder::Status::Error);
+
+    decoder.reset();
+    encoded = "0\r\n\r\n";
+    data = encoded.data();
+    BOOST_CHECK(decoder.decode(data, data + encoded.size(), chunk) == ChunkedDecoder::Status::Done);
+    BOOST_CHECK_EQUAL(data, encoded.data() + encoded.size());
+}
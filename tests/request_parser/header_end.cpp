@@ -0,0 +1,77 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <algorithm>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/http/Parser.hpp"
+
+using HTTPP::HTTP::Parser;
+
+static size_t reference(const std::string& str)
+{
+    auto pos = str.find("\r\n\r\n");
+    return pos == std::string::npos ? 0 : pos + 4;
+}
+
+BOOST_AUTO_TEST_CASE(find_at_every_offset)
+{
+    // Cover the vectorized blocks and the scalar tail, with decoys made of
+    // partial markers.
+    for (size_t prefix = 0; prefix < 100; ++prefix)
+    {
+        std::string str;
+        for (size_t i = 0; i < prefix; ++i)
+        {
+            str += "a\r\n\r"[i % 4];
+        }
+        str += "\r\n\r\n";
+        str += "trailing";
+
+        BOOST_CHECK_EQUAL(Parser::findHeaderEnd(str.data(), str.size()), reference(str));
+        BOOST_CHECK(Parser::isComplete(str.data(), str.size()));
+
+        auto truncated = str.substr(0, reference(str) - 1);
+        BOOST_CHECK_EQUAL(Parser::findHeaderEnd(truncated.data(), truncated.size()), 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_scan)
+{
+    const std::string request =
+        "GET / HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Cookie: " + std::string(300, 'c') + "\r\n"
+        "\r\n";
+
+    // Feed the request a few bytes at a time, as a slow client would.
+    for (size_t step = 1; step < 40; ++step)
+    {
+        size_t scanned = 0;
+        size_t found = 0;
+        for (size_t n = std::min(step, request.size()); !found; n = std::min(n + step, request.size()))
+        {
+            found = Parser::findHeaderEnd(request.data(), n, scanned);
+            scanned = n < 3 ? 0 : n - 3;
+            BOOST_REQUIRE(found || n < request.size());
+        }
+
+        BOOST_CHECK_EQUAL(found, request.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(too_short)
+{
+    BOOST_CHECK_EQUAL(Parser::findHeaderEnd("\r\n\r", 3), 0u);
+    BOOST_CHECK_EQUAL(Parser::findHeaderEnd("\r\n\r\n", 4), 4u);
+    BOOST_CHECK_EQUAL(Parser::findHeaderEnd("\r\n\r\n", 4, 1), 0u);
+}
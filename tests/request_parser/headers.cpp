@@ -8,6 +8,8 @@
  *
  */
 
+#include <limits>
+#include <memory>
 #include <sstream>
 
 #include <boost/test/unit_test.hpp>
@@ -91,4 +93,181 @@ BOOST_AUTO_TEST_CASE(parser_ragel)
     BOOST_CHECK(request.headers[4] == HTTPP::HTTP::HeaderRef("Incomplete2", ""));
     BOOST_CHECK(request.headers[5] == HTTPP::HTTP::HeaderRef("Test2", "Test3"));
 }
+
+BOOST_AUTO_TEST_CASE(relocate)
+{
+    const std::string query =
+        "POST /test?key=value&empty HTTP/1.1\r\n"
+        "Test: coucou\r\n"
+        "Content-Type:\r\n"
+        "\r\n";
+
+    auto buffer = std::make_unique<std::vector<char>>(std::begin(query), std::end(query));
+
+    Request request;
+    size_t consumed = 0;
+    BOOST_REQUIRE(Parser::parse(buffer->data(), buffer->data() + buffer->size(), consumed, request));
+
+    // Move the request to a new buffer and scrub the old one.
+    std::vector<char> moved(*buffer);
+    request.relocate(buffer->data(), buffer->data() + buffer->size(), moved.data());
+    std::fill(buffer->begin(), buffer->end(), 'X');
+    buffer.reset();
+
+    BOOST_CHECK_EQUAL(request.uri, "/test");
+    BOOST_CHECK(request.headers[0] == HTTPP::HTTP::HeaderRef("Test", "coucou"));
+    BOOST_CHECK(request.headers[1] == HTTPP::HTTP::HeaderRef("Content-Type", ""));
+    BOOST_CHECK_EQUAL(request.query_params[0].first, "key");
+    BOOST_CHECK_EQUAL(request.query_params[0].second, "value");
+    BOOST_CHECK_EQUAL(request.query_params[1].first, "empty");
+    BOOST_CHECK_EQUAL(request.query_params[1].second, "");
+}
+
+BOOST_AUTO_TEST_CASE(framing_headers)
+{
+    const std::string query =
+        "POST / HTTP/1.0\r\n"
+        "host: example.com:8080 \r\n"
+        "Connection: keep-alive\r\n"
+        "Content-Length: 18446744073709551615\r\n"
+        "Transfer-Encoding: gzip, Chunked\r\n"
+        "\r\n";
+
+    Request request;
+    size_t consumed = 0;
+    BOOST_REQUIRE(Parser::parse(query.data(), query.data() + query.size(), consumed, request));
+
+    BOOST_CHECK_EQUAL(request.host, "example.com:8080");
+    BOOST_CHECK(request.has_content_length);
+    BOOST_CHECK_EQUAL(request.content_length, std::numeric_limits<size_t>::max());
+    BOOST_CHECK(request.chunked);
+    // Both a length and chunked: the connection is not kept alive.
+    BOOST_CHECK(request.connection == Request::ConnectionOption::Close);
+    BOOST_CHECK(!request.keepAlive());
+
+    request.clear();
+    BOOST_CHECK(!request.has_content_length);
+    BOOST_CHECK(!request.chunked);
+    BOOST_CHECK(!request.keepAlive());
+}
+
+BOOST_AUTO_TEST_CASE(connection_options)
+{
+    auto connection = [](const std::string& headers)
+    {
+        const std::string query = "GET / HTTP/1.0\r\n" + headers + "\r\n";
+        Request request;
+        size_t consumed = 0;
+        BOOST_REQUIRE(Parser::parse(query.data(), query.data() + query.size(), consumed, request));
+        return request.connection;
+    };
+
+    using Option = Request::ConnectionOption;
+    BOOST_CHECK(connection("") == Option::Default);
+    BOOST_CHECK(connection("Connection: keep-alive, Upgrade\r\n") == Option::KeepAlive);
+    BOOST_CHECK(connection("Connection: TE ,close\r\n") == Option::Close);
+    BOOST_CHECK(connection("Connection: Upgrade\r\nConnection: Keep-Alive\r\n") == Option::KeepAlive);
+    BOOST_CHECK(connection("Connection: keep-alive\r\nConnection: close\r\n") == Option::Close);
+    BOOST_CHECK(connection("Connection: close, keep-alive\r\n") == Option::Close);
+    BOOST_CHECK(connection("Connection: closed, keep-alives\r\n") == Option::Default);
+
+    // Smuggling attempts, in both orders
+    BOOST_CHECK(
+        connection("Connection: keep-alive\r\nTransfer-Encoding: chunked\r\nContent-Length: 4\r\n")
+        == Option::Close
+    );
+    BOOST_CHECK(
+        connection("Content-Length: 4\r\nConnection: keep-alive\r\nTransfer-Encoding: chunked\r\n")
+        == Option::Close
+    );
+}
+
+BOOST_AUTO_TEST_CASE(default_framing)
+{
+    const std::string query = "GET / HTTP/1.1\r\nTransfer-Encoding: chunked, gzip\r\n\r\n";
+
+    Request request;
+    size_t consumed = 0;
+    BOOST_REQUIRE(Parser::parse(query.data(), query.data() + query.size(), consumed, request));
+
+    BOOST_CHECK(request.connection == Request::ConnectionOption::Default);
+    BOOST_CHECK(request.keepAlive());
+    BOOST_CHECK(!request.has_content_length);
+    BOOST_CHECK(!request.chunked);
+    BOOST_CHECK(request.host.empty());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_content_length)
+{
+    for (std::string length : {"12a", "-1", "18446744073709551616", " ", "1 2"})
+    {
+        const std::string query = "POST / HTTP/1.1\r\nContent-Length: " + length + "\r\n\r\n";
+        Request request;
+        size_t consumed = 0;
+        BOOST_CHECK(!Parser::parse(query.data(), query.data() + query.size(), consumed, request));
+    }
+
+    const std::string conflicting =
+        "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n";
+    Request request;
+    size_t consumed = 0;
+    BOOST_CHECK(!Parser::parse(conflicting.data(), conflicting.data() + conflicting.size(), consumed, request));
+}
+
+BOOST_AUTO_TEST_CASE(header_ids)
+{
+    using HTTPP::HTTP::HeaderId;
+
+    for (size_t i = 0; i < HTTPP::HTTP::NB_HEADER_IDS; ++i)
+    {
+        auto id = HeaderId(i);
+        std::string name(HTTPP::HTTP::to_string(id));
+        BOOST_CHECK(HTTPP::HTTP::header_id_from(name) == id);
+
+        for (auto& c : name)
+        {
+            c = ::tolower(c);
+        }
+        BOOST_CHECK(HTTPP::HTTP::header_id_from(name) == id);
+
+        name.back() = '_';
+        BOOST_CHECK(HTTPP::HTTP::header_id_from(name) == HeaderId::Unknown);
+    }
+
+    BOOST_CHECK(HTTPP::HTTP::header_id_from("") == HeaderId::Unknown);
+    BOOST_CHECK(HTTPP::HTTP::header_id_from("X") == HeaderId::Unknown);
+    BOOST_CHECK(HTTPP::HTTP::header_id_from("X-Custom") == HeaderId::Unknown);
+}
+
+BOOST_AUTO_TEST_CASE(header_lookup)
+{
+    using HTTPP::HTTP::HeaderId;
+
+    const std::string query =
+        "GET / HTTP/1.1\r\n"
+        "accept: text/html\r\n"
+        "X-Custom: 1\r\n"
+        "Accept: */*\r\n"
+        "Content-Type:\r\n"
+        "\r\n";
+
+    Request request;
+    size_t consumed = 0;
+    BOOST_REQUIRE(Parser::parse(query.data(), query.data() + query.size(), consumed, request));
+
+    BOOST_REQUIRE_EQUAL(request.header_ids.size(), request.headers.size());
+    BOOST_CHECK(request.header_ids[0] == HeaderId::Accept);
+    BOOST_CHECK(request.header_ids[1] == HeaderId::Unknown);
+    BOOST_CHECK(request.header_ids[3] == HeaderId::ContentType);
+
+    BOOST_CHECK_EQUAL(request.header(HeaderId::Accept), "text/html");
+    BOOST_CHECK_EQUAL(request.header("ACCEPT"), "text/html");
+    BOOST_CHECK_EQUAL(request.header("x-custom"), "1");
+    BOOST_CHECK_EQUAL(request.header(HeaderId::ContentType), "");
+    BOOST_CHECK_EQUAL(request.header(HeaderId::UserAgent), "");
+    BOOST_CHECK_EQUAL(request.header("X-Missing"), "");
+
+    request.clear();
+    BOOST_CHECK_EQUAL(request.header(HeaderId::Accept), "");
+}
 #endif
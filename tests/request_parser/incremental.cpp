@@ -0,0 +1,155 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/http/Parser.hpp"
+#include "httpp/http/Request.hpp"
+
+using HTTPP::HTTP::Parser;
+using HTTPP::HTTP::Request;
+
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+
+static const std::string REQUEST =
+    "POST /path/to/resource?a=1&bb=22&ccc HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:120.0) Gecko/20100101\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Cookie: " + std::string(400, 'c') + "\r\n"
+    "Content-Length: 4\r\n"
+    "\r\n"
+    "body";
+
+static const size_t HEADER_SIZE = REQUEST.size() - 4;
+
+static void check_same(const Request& expected, const Request& request)
+{
+    BOOST_CHECK(expected.method == request.method);
+    BOOST_CHECK_EQUAL(expected.uri, request.uri);
+    BOOST_CHECK_EQUAL(expected.major, request.major);
+    BOOST_CHECK_EQUAL(expected.minor, request.minor);
+    BOOST_CHECK(expected.query_params == request.query_params);
+    BOOST_CHECK(expected.headers == request.headers);
+}
+
+// Feed buffer by step bytes, the bytes already given stay in place.
+static Parser::Result feed(const std::string& buffer, size_t step, Request& request, Parser::State& state)
+{
+    auto result = Parser::Result::Incomplete;
+    for (size_t n = 0; result == Parser::Result::Incomplete && n < buffer.size();)
+    {
+        n = std::min(n + step, buffer.size());
+        result = Parser::parse(state, buffer.data(), n, request);
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(same_as_one_shot)
+{
+    Request expected;
+    size_t consumed = 0;
+    BOOST_REQUIRE(Parser::parse(REQUEST.data(), REQUEST.data() + REQUEST.size(), consumed, expected));
+    BOOST_CHECK_EQUAL(consumed, HEADER_SIZE);
+
+    for (size_t step : {1, 2, 3, 7, 64, 1000})
+    {
+        Request request;
+        Parser::State state;
+        BOOST_REQUIRE(feed(REQUEST, step, request, state) == Parser::Result::Complete);
+        BOOST_CHECK_EQUAL(state.offset, HEADER_SIZE);
+        check_same(expected, request);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_keeps_state)
+{
+    Request request;
+    Parser::State state;
+    auto half = HEADER_SIZE / 2;
+    BOOST_CHECK(Parser::parse(state, REQUEST.data(), half, request) == Parser::Result::Incomplete);
+    BOOST_CHECK_EQUAL(state.offset, half);
+    BOOST_CHECK(Parser::parse(state, REQUEST.data(), half, request) == Parser::Result::Incomplete);
+    BOOST_CHECK(Parser::parse(state, REQUEST.data(), REQUEST.size(), request) == Parser::Result::Complete);
+    BOOST_CHECK_EQUAL(state.offset, HEADER_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(early_error)
+{
+    // The error is reported as soon as the invalid byte is read, well
+    // before the end of the header block.
+    const std::string invalid = "GET /path HTTP/X.1\r\nHost: localhost\r\n\r\n";
+    Request request;
+    Parser::State state;
+    BOOST_CHECK(feed(invalid, 1, request, state) == Parser::Result::Error);
+    BOOST_CHECK_EQUAL(state.offset, invalid.find('X'));
+
+    const std::string invalid_method = "BR(EW /pot HTTP/1.1\r\n\r\n";
+    Request request2;
+    Parser::State state2;
+    BOOST_CHECK(feed(invalid_method, 1, request2, state2) == Parser::Result::Error);
+    BOOST_CHECK_EQUAL(state2.offset, invalid_method.find('('));
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_resumable_vs_two_pass)
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t iterations = 20000;
+    const size_t step = 64;
+
+    size_t checksum = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        Request request;
+        Parser::State state;
+        feed(REQUEST, step, request, state);
+        checksum += state.offset;
+    }
+    auto resumable = Clock::now() - start;
+
+    start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        // Look for the end of the header after each read, then parse
+        // everything once it is there.
+        for (size_t n = 0; n < REQUEST.size();)
+        {
+            n = std::min(n + step, REQUEST.size());
+            if (Parser::isComplete(REQUEST.data(), n))
+            {
+                Request request;
+                size_t consumed = 0;
+                Parser::parse(REQUEST.data(), REQUEST.data() + n, consumed, request);
+                checksum += consumed;
+                break;
+            }
+        }
+    }
+    auto two_pass = Clock::now() - start;
+
+    BOOST_CHECK_EQUAL(checksum, 2 * iterations * HEADER_SIZE);
+
+    auto rate = [&](Clock::duration d)
+    {
+        auto seconds = std::chrono::duration<double>(d).count();
+        return (iterations * HEADER_SIZE) / seconds / (1024 * 1024);
+    };
+
+    BOOST_TEST_MESSAGE("Resumable parser: " << rate(resumable) << " MiB/s");
+    BOOST_TEST_MESSAGE("Scan then parse: " << rate(two_pass) << " MiB/s");
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/http/Parser.hpp"
+#include "httpp/http/Request.hpp"
+
+using HTTPP::HTTP::Method;
+using HTTPP::HTTP::Parser;
+using HTTPP::HTTP::Request;
+
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+
+static Parser::Result parse(const std::string& str, Request& request)
+{
+    Parser::State state;
+    return Parser::parse(state, str.data(), str.size(), request);
+}
+
+BOOST_AUTO_TEST_CASE(known_methods)
+{
+    const std::pair<const char*, Method> methods[] = {
+        {"GET", Method::GET},
+        {"HEAD", Method::HEAD},
+        {"POST", Method::POST},
+        {"PUT", Method::PUT},
+        {"PATCH", Method::PATCH},
+        {"DELETE", Method::DELETE_},
+        {"OPTIONS", Method::OPTIONS},
+        {"TRACE", Method::TRACE},
+        {"CONNECT", Method::CONNECT},
+    };
+
+    for (const auto& method : methods)
+    {
+        Request request;
+        auto str = std::string(method.first) + " /path HTTP/1.1\r\n\r\n";
+        BOOST_REQUIRE(parse(str, request) == Parser::Result::Complete);
+        BOOST_CHECK(request.method == method.second);
+        BOOST_CHECK_EQUAL(to_string(request.method), method.first);
+        BOOST_CHECK_EQUAL(request.uri, "/path");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(extension_methods)
+{
+    // Prefixes and extensions of the known methods included
+    for (std::string name : {"BREW", "PROPFIND", "M-SEARCH", "GE", "GETS", "POS", "PATCHED", "get"})
+    {
+        Request request;
+        auto str = name + " /pot HTTP/1.1\r\n\r\n";
+        BOOST_REQUIRE(parse(str, request) == Parser::Result::Complete);
+        BOOST_CHECK(request.method == Method::EXTENSION);
+        BOOST_CHECK_EQUAL(request.method_name, name);
+        BOOST_CHECK_EQUAL(request.uri, "/pot");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_methods)
+{
+    for (std::string str : {" GET / HTTP/1.1\r\n\r\n",
+                            "GE(T / HTTP/1.1\r\n\r\n",
+                            "GET/ HTTP/1.1\r\n\r\n",
+                            "\x01 / HTTP/1.1\r\n\r\n",
+                            "P\xc3\x89T / HTTP/1.1\r\n\r\n"})
+    {
+        Request request;
+        BOOST_CHECK(parse(str, request) == Parser::Result::Error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_malformed_input)
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t iterations = 200000;
+
+    const std::vector<std::string> garbage = {
+        "GE\x01 / HTTP/1.1\r\n\r\n",
+        "POST(/ HTTP/1.1\r\n\r\n",
+        "\x16\x03\x01\x02\x00\x01\x00\x01\xfc\x03\x03",
+        "OPTIONS\x7f/ HTTP/1.1\r\n\r\n",
+        "DEL{ETE / HTTP/1.1\r\n\r\n",
+    };
+
+    size_t bytes = 0, errors = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const auto& str = garbage[i % garbage.size()];
+        Request request;
+        errors += parse(str, request) == Parser::Result::Error;
+        bytes += str.size();
+    }
+    auto machine = Clock::now() - start;
+    BOOST_CHECK_EQUAL(errors, iterations);
+
+    // What each of them used to cost: a lookup throwing on unknown names.
+    const std::vector<std::string> names = {"GE", "POS", "BREW", "OPTION", "DEL"};
+    errors = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        try
+        {
+            HTTPP::HTTP::method_from(names[i % names.size()]);
+        }
+        catch (...)
+        {
+            ++errors;
+        }
+    }
+    auto throwing = Clock::now() - start;
+    BOOST_CHECK_EQUAL(errors, iterations);
+
+    auto rate = [&](Clock::duration d)
+    {
+        return iterations / std::chrono::duration<double>(d).count();
+    };
+
+    BOOST_TEST_MESSAGE("Rejected by the machine: " << rate(machine) << " requests/s ("
+                       << bytes / std::chrono::duration<double>(machine).count() / (1024 * 1024)
+                       << " MiB/s)");
+    BOOST_TEST_MESSAGE("Rejected by a throwing lookup: " << rate(throwing) << " requests/s");
+}
+
+#endif
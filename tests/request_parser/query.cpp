@@ -8,7 +8,10 @@
  *
  */
 
+#include <chrono>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -158,3 +161,119 @@ BOOST_AUTO_TEST_CASE(empty_query)
     BOOST_CHECK_EQUAL(params["y"], "");
     BOOST_CHECK_EQUAL(params["z"], "");
 }
+
+BOOST_AUTO_TEST_CASE(indexed_lookup)
+{
+    auto request = parse("/?z=z&y=y&a=a&b=b&a=again&c%20d=cd&empty");
+    BOOST_CHECK_EQUAL(request.queryParam("z"), "z");
+    BOOST_CHECK_EQUAL(request.queryParam("b"), "b");
+    BOOST_CHECK_EQUAL(request.queryParam("a"), "a");
+    BOOST_CHECK_EQUAL(request.queryParam("c d"), "cd");
+    BOOST_CHECK_EQUAL(request.queryParam("missing"), "");
+    BOOST_CHECK(request.findQueryParam("empty") != nullptr);
+    BOOST_CHECK(request.findQueryParam("missing") == nullptr);
+    BOOST_CHECK(request.findQueryParam("c%20d") == nullptr);
+
+    // More parameters than the inline capacity of the index
+    std::string uri = "/?";
+    for (int i = 0; i < 100; ++i)
+    {
+        uri += "k" + std::to_string(i) + "=" + std::to_string(i) + "&";
+    }
+    request = parse(uri);
+    for (int i = 0; i < 100; ++i)
+    {
+        BOOST_CHECK_EQUAL(request.queryParam("k" + std::to_string(i)), std::to_string(i));
+    }
+
+    request.clear();
+    BOOST_CHECK(request.findQueryParam("k1") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_lookup)
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t iterations = 20000;
+
+    std::string uri = "/search?";
+    std::vector<std::string> keys;
+    for (int i = 0; i < 24; ++i)
+    {
+        keys.push_back("param_" + std::to_string(i));
+        uri += keys.back() + "=" + std::to_string(i) + "&";
+    }
+    auto request = parse(uri);
+
+    // A dozen lookups per request, some of them missing
+    std::vector<std::string> wanted(keys.begin(), keys.begin() + 10);
+    wanted.push_back("sort");
+    wanted.push_back("page");
+
+    // A fresh copy of the parameters for each request, the index has to be
+    // built again every time.
+    size_t sorted_found = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        Request copy;
+        copy.query_params = request.query_params;
+        auto params = copy.getSortedQueryParams();
+        for (const auto& key : wanted)
+        {
+            sorted_found += !(params[Request::QueryParamRef::first_type(key)] == "");
+        }
+    }
+    auto sorted = Clock::now() - start;
+
+    size_t indexed_found = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        Request copy;
+        copy.query_params = request.query_params;
+        for (const auto& key : wanted)
+        {
+            indexed_found += copy.findQueryParam(key) != nullptr;
+        }
+    }
+    auto indexed = Clock::now() - start;
+
+    BOOST_CHECK_EQUAL(sorted_found, 10 * iterations);
+    BOOST_CHECK_EQUAL(indexed_found, 10 * iterations);
+
+    auto per_request = [&](Clock::duration d)
+    {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+
+    BOOST_TEST_MESSAGE("getSortedQueryParams: " << per_request(sorted) << " ns/request");
+    BOOST_TEST_MESSAGE("findQueryParam: " << per_request(indexed) << " ns/request");
+}
+
+BOOST_AUTO_TEST_CASE(escaped_keys)
+{
+    auto request = parse("/?a%20b=1&c+d=2&e%3D=3");
+    testQueryParam(request, "a b", "1");
+    testQueryParam(request, "c d", "2");
+    testQueryParam(request, "e=", "3");
+
+    auto params = request.getSortedQueryParams();
+    BOOST_CHECK_EQUAL(params["c d"], "2");
+}
+
+#if HTTPP_PARSER_BACKEND_IS_RAGEL
+BOOST_AUTO_TEST_CASE(keys_are_views)
+{
+    const std::string query = "GET /?key=value&other%2Dkey HTTP/1.1\r\n\r\n";
+    Request request;
+    size_t consumed;
+    BOOST_REQUIRE(Parser::parse(query.data(), query.data() + query.size(), consumed, request));
+    BOOST_REQUIRE_EQUAL(request.query_params.size(), 2);
+
+    // Nothing is decoded or copied until asked for
+    auto key = request.query_params[0].first.raw();
+    BOOST_CHECK(key.data() == query.data() + query.find("key"));
+    BOOST_CHECK_EQUAL(request.query_params[1].first.raw(), "other%2Dkey");
+    BOOST_CHECK_EQUAL(request.query_params[1].first, "other-key");
+}
+#endif
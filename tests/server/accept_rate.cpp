@@ -0,0 +1,148 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+
+using namespace HTTPP;
+using namespace std::string_literals;
+
+using HTTPP::HTTP::Connection;
+
+static const std::string REQUEST =
+    "GET / HTTP/1.1\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+
+static const int CLIENTS = 8;
+static const int CONNECTIONS_PER_CLIENT = 150;
+
+void handler(Connection* connection)
+{
+    connection->response()
+        .setCode(HTTP::HttpCode::Ok)
+        .setBody("")
+        .connectionShouldBeClosed(true);
+    connection->sendResponse();
+}
+
+// Opens CLIENTS * CONNECTIONS_PER_CLIENT short lived connections as fast as
+// possible and returns the number of connections served per second.
+static double connection_storm(size_t accept_depth)
+{
+    HttpServer server(4);
+    server.setAcceptDepth(accept_depth);
+    server.start();
+    server.setSink(&handler);
+    server.bind("127.0.0.1");
+
+    std::atomic_int served = {0};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> clients;
+    for (int i = 0; i < CLIENTS; ++i)
+    {
+        clients.emplace_back(
+            [&served]
+            {
+                using boost::asio::ip::tcp;
+                boost::asio::io_service io_service;
+                tcp::endpoint endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 8000);
+                for (int j = 0; j < CONNECTIONS_PER_CLIENT; ++j)
+                {
+                    tcp::socket s(io_service);
+                    s.connect(endpoint);
+                    boost::asio::write(s, boost::asio::buffer(REQUEST));
+
+                    boost::asio::streambuf b;
+                    boost::system::error_code ec;
+                    boost::asio::read_until(s, b, "\r\n\r\n", ec);
+                    if (!ec)
+                    {
+                        ++served;
+                    }
+                }
+            }
+        );
+    }
+
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK_EQUAL(served, CLIENTS * CONNECTIONS_PER_CLIENT);
+    return served / elapsed.count();
+}
+
+BOOST_AUTO_TEST_CASE(accept_rate)
+{
+    auto single = connection_storm(1);
+    auto deep = connection_storm(16);
+
+    BOOST_TEST_MESSAGE("accept depth 1: " << single << " connections/s");
+    BOOST_TEST_MESSAGE("accept depth 16: " << deep << " connections/s");
+}
+
+BOOST_AUTO_TEST_CASE(pending_accepts_not_counted)
+{
+    HttpServer server(2);
+    server.setAcceptDepth(8);
+    server.start();
+    server.setSink(
+        [](Connection* connection)
+        {
+            connection->response().setCode(HTTP::HttpCode::Ok).setBody("");
+            connection->sendResponse();
+        }
+    );
+    server.bind("127.0.0.1");
+    BOOST_CHECK_EQUAL(server.getNbAcceptedConnection(), 0);
+    BOOST_CHECK_GE(server.getNbConnection(), 8);
+
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::endpoint endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 8000);
+    std::vector<tcp::socket> sockets;
+    for (int i = 0; i < 3; ++i)
+    {
+        sockets.emplace_back(io_service);
+        sockets.back().connect(endpoint);
+        boost::asio::write(sockets.back(), boost::asio::buffer("GET / HTTP/1.1\r\n\r\n"s));
+        boost::asio::streambuf b;
+        boost::asio::read_until(sockets.back(), b, "\r\n\r\n");
+    }
+    BOOST_CHECK_EQUAL(server.getNbAcceptedConnection(), 3);
+
+    sockets.clear();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (server.getNbAcceptedConnection() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_EQUAL(server.getNbAcceptedConnection(), 0);
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(invalid_accept_depth)
+{
+    HttpServer server;
+    BOOST_CHECK_THROW(server.setAcceptDepth(0), std::invalid_argument);
+}
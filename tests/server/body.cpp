@@ -11,6 +11,7 @@
 #include <chrono>
 #include <iostream>
 #include <istream>
+#include <sstream>
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
@@ -272,3 +273,53 @@ BOOST_AUTO_TEST_CASE(body_too_big)
 
     BOOST_CHECK_EQUAL(line, "HTTP/1.1 413 RequestEntityTooLarge");
 }
+
+static const std::string CHUNKED_REQUEST =
+// clang-format off
+    "POST / HTTP/1.1\r\n"
+    "Host: localhost:8000\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "\r\n";
+// clang-format on
+
+BOOST_AUTO_TEST_CASE(read_chunked)
+{
+    BODY.clear();
+    std::string encoded;
+    for (int i = 1; i < 40; ++i)
+    {
+        std::string chunk(i * 37, char('a' + i % 26));
+        BODY += chunk;
+
+        std::ostringstream size;
+        size << std::hex << chunk.size();
+        encoded += size.str() + (i % 2 ? ";ext=1" : "") + "\r\n" + chunk + "\r\n";
+    }
+    encoded += "0\r\nTrailer: value\r\n\r\n";
+
+    HttpServer server;
+    server.start();
+    server.setSink(&handler2);
+    server.bind("localhost");
+
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::socket s(io_service);
+    tcp::resolver resolver(io_service);
+    boost::asio::connect(s, resolver.resolve({"localhost", "8000"}));
+    boost::asio::write(s, boost::asio::buffer(CHUNKED_REQUEST + encoded.substr(0, 100)));
+    for (size_t i = 100; i < encoded.size(); i += 1000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        boost::asio::write(s, boost::asio::buffer(encoded.substr(i, 1000)));
+    }
+
+    boost::asio::streambuf b;
+    boost::asio::read_until(s, b, "\r\n");
+    std::istream is(&b);
+    std::string line;
+    std::getline(is, line);
+    boost::trim(line);
+
+    BOOST_CHECK_EQUAL(line, "HTTP/1.1 200 Ok");
+}
@@ -0,0 +1,390 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+#include "httpp/http/helper/ChunkStream.hpp"
+#include "httpp/http/helper/ChunkedDecoder.hpp"
+
+#include "helpers.hpp"
+
+using namespace HTTPP;
+using namespace std::chrono_literals;
+
+using HTTPP::HTTP::Connection;
+using HTTPP::HTTP::Response;
+using HTTPP::HTTP::helper::ChunkedDecoder;
+using HTTPP::HTTP::helper::ChunkStream;
+
+using boost::asio::ip::tcp;
+
+static std::string make_row(size_t i)
+{
+    return "row " + std::to_string(i) + ": " + std::string(i % 1500, 'x') + "\n";
+}
+
+// Pushes rows from its own thread, waiting whenever the stream is full.
+struct Producer
+{
+    explicit Producer(size_t rows, size_t max_queued)
+    : stream(std::make_shared<ChunkStream>(max_queued))
+    , rows(rows)
+    {
+        stream->onReady(
+            [this](const boost::system::error_code& ec)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = ec;
+                ready = true;
+                cv.notify_one();
+            }
+        );
+    }
+
+    void run()
+    {
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if (!stream->push(make_row(i)))
+            {
+                ++waits;
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return ready; });
+                ready = false;
+                if (error)
+                {
+                    return;
+                }
+            }
+        }
+        stream->close();
+    }
+
+    std::shared_ptr<ChunkStream> stream;
+    size_t rows;
+    size_t waits = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool ready = false;
+    boost::system::error_code error;
+};
+
+// Read a chunked response up to its last chunk, the head is returned in
+// head and the decoded body returned.
+static std::string read_chunked_response(tcp::socket& s, std::string* head = nullptr)
+{
+    boost::asio::streambuf buffer;
+    auto size = boost::asio::read_until(s, buffer, "\r\n\r\n");
+    std::string received(boost::asio::buffers_begin(buffer.data()), boost::asio::buffers_end(buffer.data()));
+    if (head)
+    {
+        *head = received.substr(0, size);
+    }
+    received.erase(0, size);
+
+    ChunkedDecoder decoder;
+    std::string body;
+    size_t decoded = 0;
+    for (;;)
+    {
+        const char* data = received.data() + decoded;
+        const char* end = received.data() + received.size();
+        std::string_view chunk;
+        auto status = decoder.decode(data, end, chunk);
+        decoded = data - received.data();
+        if (status == ChunkedDecoder::Status::Data)
+        {
+            body.append(chunk);
+            continue;
+        }
+
+        if (status == ChunkedDecoder::Status::Done)
+        {
+            return body;
+        }
+
+        BOOST_REQUIRE(status == ChunkedDecoder::Status::NeedMore);
+        char more[8192];
+        auto n = s.read_some(boost::asio::buffer(more));
+        received.append(more, n);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(backpressure)
+{
+    static const size_t ROWS = 5000;
+    Producer producer(ROWS, 16 * 1024);
+    std::thread producer_thread;
+
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            connection->response().setCode(HTTP::HttpCode::Ok).setBody(producer.stream);
+            connection->sendResponse();
+            producer_thread = std::thread([&] { producer.run(); });
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    boost::asio::write(s, boost::asio::buffer(std::string("GET /export HTTP/1.1\r\n\r\n")));
+
+    std::string head;
+    auto body = read_chunked_response(s, &head);
+    producer_thread.join();
+
+    std::string expected;
+    for (size_t i = 0; i < ROWS; ++i)
+    {
+        expected += make_row(i);
+    }
+
+    BOOST_CHECK(head.find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+    BOOST_CHECK(body == expected);
+    BOOST_CHECK(!producer.error);
+    // About 3.7MB through a 16KB queue
+    BOOST_CHECK_GT(producer.waits, 0u);
+    BOOST_TEST_MESSAGE("Producer waited " << producer.waits << " times");
+
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(idle_producer_does_not_block_the_thread)
+{
+    auto stream = std::make_shared<ChunkStream>();
+
+    // A single I/O thread serves both connections.
+    HttpServer server(1);
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            auto& response = connection->response().setCode(HTTP::HttpCode::Ok);
+            if (connection->request().uri == "/stream")
+            {
+                response.setBody(stream);
+            }
+            else
+            {
+                response.setBody("other");
+            }
+            connection->sendResponse();
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto streamed = connect(io_service);
+    boost::asio::write(streamed, boost::asio::buffer(std::string("GET /stream HTTP/1.1\r\n\r\n")));
+    std::this_thread::sleep_for(100ms);
+
+    auto other = connect(io_service);
+    boost::asio::write(other, boost::asio::buffer(std::string("GET /other HTTP/1.1\r\n\r\n")));
+    boost::asio::streambuf buffer;
+    boost::asio::read_until(other, buffer, "\r\n\r\nother");
+
+    stream->push("first");
+    stream->push(" second");
+    stream->close();
+    BOOST_CHECK_EQUAL(read_chunked_response(streamed), "first second");
+
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(producer_told_of_disconnection)
+{
+    Producer producer(1000000, 64 * 1024);
+    std::thread producer_thread;
+
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            connection->response().setCode(HTTP::HttpCode::Ok).setBody(producer.stream);
+            connection->sendResponse();
+            producer_thread = std::thread([&] { producer.run(); });
+        }
+    );
+    server.bind("localhost");
+
+    {
+        boost::asio::io_service io_service;
+        auto s = connect(io_service);
+        boost::asio::write(s, boost::asio::buffer(std::string("GET / HTTP/1.1\r\n\r\n")));
+        boost::asio::streambuf buffer;
+        boost::asio::read_until(s, buffer, "\r\n\r\n");
+    }
+
+    auto done = std::async(std::launch::async, [&] { producer_thread.join(); });
+    BOOST_REQUIRE(done.wait_for(5s) == std::future_status::ready);
+    BOOST_CHECK(producer.error);
+    BOOST_CHECK(producer.stream->error());
+    BOOST_CHECK(!producer.stream->push("ignored"));
+
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(stop_with_idle_producer)
+{
+    auto stream = std::make_shared<ChunkStream>();
+    std::promise<void> streaming;
+
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            connection->response().setCode(HTTP::HttpCode::Ok).setBody(stream);
+            connection->sendResponse();
+            streaming.set_value();
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    boost::asio::write(s, boost::asio::buffer(std::string("GET / HTTP/1.1\r\n\r\n")));
+    boost::asio::streambuf buffer;
+    boost::asio::read_until(s, buffer, "\r\n\r\n");
+    streaming.get_future().wait();
+
+    // The producer never pushes nor closes, the response waits for it.
+    auto stopped = std::async(std::launch::async, [&] { server.stop(); });
+    BOOST_REQUIRE(stopped.wait_for(2s) == std::future_status::ready);
+    BOOST_CHECK(stream->error() == boost::asio::error::operation_aborted);
+    BOOST_CHECK(!stream->push("ignored"));
+}
+
+static Response::ChunkedResponseCallback make_rows(size_t rows, std::string& expected)
+{
+    for (size_t i = 0; i < rows; ++i)
+    {
+        expected += make_row(i % 20);
+    }
+
+    return [rows, i = size_t(0), row = std::string()]() mutable -> std::string_view
+    {
+        if (i == rows)
+        {
+            return {};
+        }
+        row = make_row(i++ % 20);
+        return row;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(callback_chunks_coalesced)
+{
+    std::string expected;
+    Response response(HTTP::HttpCode::Ok, make_rows(1000, expected));
+    size_t writes = 0;
+    BOOST_CHECK(send_chunked(response, &writes).body == expected);
+    // The head, one write per chunk, then the end
+    BOOST_CHECK_EQUAL(writes, 1002u);
+
+    expected.clear();
+    response.setBody(make_rows(1000, expected))
+        .setChunkCoalescing(4096, std::chrono::seconds(10));
+    BOOST_CHECK(send_chunked(response, &writes).body == expected);
+    BOOST_CHECK_LT(writes, 10u);
+    BOOST_TEST_MESSAGE("1000 rows sent in " << writes << " writes");
+
+    // A large chunk is written from the callback storage, and ends the
+    // gathering.
+    std::string large(100000, 'l');
+    bool sent = false;
+    response.setBody(
+        [&]() -> std::string_view
+        {
+            if (sent)
+            {
+                return {};
+            }
+            sent = true;
+            return large;
+        }
+    );
+    BOOST_CHECK(send_chunked(response, &writes).body == large);
+}
+
+BOOST_AUTO_TEST_CASE(stream_chunks_coalesced)
+{
+    auto stream = std::make_shared<ChunkStream>(1024 * 1024);
+    std::string expected;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        expected += make_row(i % 20);
+        stream->push(make_row(i % 20));
+    }
+    stream->close();
+
+    Response response(HTTP::HttpCode::Ok);
+    response.setBody(stream);
+    size_t writes = 0;
+    BOOST_CHECK(send_chunked(response, &writes).body == expected);
+    // The head, then everything queued along with the end
+    BOOST_CHECK_EQUAL(writes, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(stream_delay_and_flush)
+{
+    auto stream = std::make_shared<ChunkStream>();
+
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            connection->response()
+                .setCode(HTTP::HttpCode::Ok)
+                .setBody(stream)
+                .setChunkCoalescing(1024 * 1024, 200ms);
+            connection->sendResponse();
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    boost::asio::write(s, boost::asio::buffer(std::string("GET / HTTP/1.1\r\n\r\n")));
+    boost::asio::streambuf buffer;
+    boost::asio::read_until(s, buffer, "\r\n\r\n");
+
+    // Held back until the delay expires
+    auto start = std::chrono::steady_clock::now();
+    stream->push("delayed");
+    boost::asio::read_until(s, buffer, "delayed\r\n");
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= 200ms);
+
+    // Sent right away
+    start = std::chrono::steady_clock::now();
+    stream->push("flushed", true);
+    boost::asio::read_until(s, buffer, "flushed\r\n");
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < 200ms);
+
+    stream->close();
+    boost::asio::read_until(s, buffer, "0\r\n\r\n");
+
+    server.stop();
+}
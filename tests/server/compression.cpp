@@ -0,0 +1,286 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+#include "httpp/http/helper/Compression.hpp"
+
+#include "helpers.hpp"
+
+using namespace HTTPP;
+
+using HTTPP::HTTP::Connection;
+using HTTPP::HTTP::HttpCode;
+using HTTPP::HTTP::Response;
+using HTTPP::HTTP::helper::ContentCoding;
+using HTTPP::HTTP::helper::negotiate_coding;
+
+static const std::string JSON = []
+{
+    std::string s = "[";
+    for (int i = 0; i < 500; ++i)
+    {
+        s += "{\"id\": " + std::to_string(i) + ", \"name\": \"item\", \"enabled\": true},";
+    }
+    s.back() = ']';
+    return s;
+}();
+
+BOOST_AUTO_TEST_CASE(negotiation)
+{
+    BOOST_CHECK(negotiate_coding("") == ContentCoding::Identity);
+    BOOST_CHECK(negotiate_coding("gzip") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip, deflate, br") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("deflate") == ContentCoding::Deflate);
+    BOOST_CHECK(negotiate_coding("x-gzip") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("GZIP;q=0.5, deflate;q=0.8") == ContentCoding::Deflate);
+    BOOST_CHECK(negotiate_coding("deflate;q=0.5 , gzip ;q=0.5") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0") == ContentCoding::Identity);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.000, deflate") == ContentCoding::Deflate);
+    BOOST_CHECK(negotiate_coding("*") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("*;q=0.1, gzip;q=0") == ContentCoding::Deflate);
+    BOOST_CHECK(negotiate_coding("br, identity") == ContentCoding::Identity);
+
+    // Malformed weights are ignored, not taken as 1
+    BOOST_CHECK(negotiate_coding("gzip;q=1.000, deflate;q=0.999") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=1.5") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=1.001") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=0.5000") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=0.x") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=10") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=-1") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0.5, deflate;q=.9") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=abc") == ContentCoding::Identity);
+    BOOST_CHECK(negotiate_coding("*;q=0.2, gzip;q=oops") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip;q=0., deflate;q=1.") == ContentCoding::Deflate);
+}
+
+BOOST_AUTO_TEST_CASE(compressible_types)
+{
+    using HTTPP::HTTP::helper::is_compressible;
+    BOOST_CHECK(is_compressible(""));
+    BOOST_CHECK(is_compressible("application/json"));
+    BOOST_CHECK(is_compressible("text/html; charset=utf-8"));
+    BOOST_CHECK(is_compressible("image/svg+xml"));
+    BOOST_CHECK(!is_compressible("image/png"));
+    BOOST_CHECK(!is_compressible("Video/mp4"));
+    BOOST_CHECK(!is_compressible("application/gzip"));
+    BOOST_CHECK(!is_compressible("application/zip"));
+    BOOST_CHECK(!is_compressible("font/woff2"));
+}
+
+BOOST_AUTO_TEST_CASE(fixed_body)
+{
+    Response response(HttpCode::Ok, JSON);
+    response.addHeader("Content-Type", "application/json");
+    response.setContentCoding(ContentCoding::Gzip, {});
+    auto sent = split(serialize(response));
+    BOOST_CHECK(sent.has("Content-Encoding: gzip"));
+    BOOST_CHECK(sent.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(sent.has("Content-Length: " + std::to_string(sent.body.size())));
+    BOOST_CHECK_LT(sent.body.size(), JSON.size() / 4);
+    BOOST_CHECK(inflate(sent.body) == JSON);
+
+    // The state is reused for the next response
+    response.setContentCoding(ContentCoding::Deflate, {1, 1024});
+    sent = split(serialize(response));
+    BOOST_CHECK(sent.has("Content-Encoding: deflate"));
+    BOOST_CHECK(inflate(sent.body) == JSON);
+
+    // Shared segments are compressed as one body
+    auto shared = std::make_shared<const std::string>(JSON);
+    response.setBody("[").appendBody({boost::asio::buffer(*shared), shared});
+    response.setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(inflate(split(serialize(response)).body) == "[" + JSON);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_etag)
+{
+    Response response(HttpCode::Ok, JSON);
+    response.setETag("v1");
+    response.setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(split(serialize(response)).has("ETag: \"v1-gzip\""));
+
+    response.setETag("v1", true).setContentCoding(ContentCoding::Deflate, {});
+    BOOST_CHECK(split(serialize(response)).has("ETag: W/\"v1-deflate\""));
+
+    // The identity variant keeps the tag as it is
+    response.setETag("v1").setContentCoding(ContentCoding::Identity, {});
+    BOOST_CHECK(split(serialize(response)).has("ETag: \"v1\""));
+
+    // Validating a variant validates the representation
+    BOOST_CHECK(response.isNotModified("\"v1-gzip\"", ""));
+    BOOST_CHECK(response.isNotModified("W/\"v1-deflate\"", ""));
+    BOOST_CHECK(response.isNotModified("\"v1\"", ""));
+    BOOST_CHECK(!response.isNotModified("\"v1-zip\"", ""));
+    BOOST_CHECK(!response.isNotModified("\"v2-gzip\"", ""));
+    BOOST_CHECK(!response.isNotModified("\"v1-gzip", ""));
+}
+
+BOOST_AUTO_TEST_CASE(not_compressed)
+{
+    // The client does not accept it, the response still varies.
+    Response response(HttpCode::Ok, JSON);
+    response.setContentCoding(ContentCoding::Identity, {});
+    auto sent = split(serialize(response));
+    BOOST_CHECK(sent.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(sent.head.find("Content-Encoding") == std::string::npos);
+    BOOST_CHECK(sent.body == JSON);
+
+    // Too small
+    response.setBody("small").setContentCoding(ContentCoding::Gzip, {});
+    sent = split(serialize(response));
+    BOOST_CHECK(sent.head.find("Vary") == std::string::npos);
+    BOOST_CHECK_EQUAL(sent.body, "small");
+
+    // Already compressed
+    response.setBody(JSON).addHeader("Content-Type", "image/png");
+    sent = split(serialize(response));
+    BOOST_CHECK(sent.head.find("Content-Encoding") == std::string::npos);
+    BOOST_CHECK(sent.body == JSON);
+
+    // Opted out
+    response.clear();
+    response.setBody(JSON).setCompression(false).setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(split(serialize(response)).body == JSON);
+
+    // Encoded by the handler
+    response.clear();
+    response.setBody(JSON).addHeader("Content-Encoding", "br");
+    response.setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(split(serialize(response)).body == JSON);
+
+    // Random bytes do not shrink
+    std::string random(4096, 0);
+    for (auto& c : random)
+    {
+        c = char(::rand());
+    }
+    response.clear();
+    response.setBody(random).setContentCoding(ContentCoding::Gzip, {});
+    sent = split(serialize(response));
+    BOOST_CHECK(sent.head.find("Content-Encoding") == std::string::npos);
+    BOOST_CHECK(sent.body == random);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_streams)
+{
+    size_t calls = 0;
+    Response response(
+        HttpCode::Ok,
+        [&]() -> std::string_view
+        {
+            return calls++ < 20 ? JSON : std::string_view();
+        }
+    );
+    response.setContentCoding(ContentCoding::Gzip, {});
+    auto sent = send_chunked(response);
+    BOOST_CHECK(sent.has("Content-Encoding: gzip"));
+    BOOST_CHECK(sent.has("Transfer-Encoding: chunked"));
+
+    std::string expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        expected += JSON;
+    }
+    BOOST_CHECK(inflate(sent.body) == expected);
+
+    auto stream = std::make_shared<HTTP::helper::ChunkStream>(1024 * 1024);
+    for (int i = 0; i < 20; ++i)
+    {
+        stream->push(JSON);
+    }
+    stream->close();
+    response.clear();
+    response.setBody(stream).setContentCoding(ContentCoding::Deflate, {});
+    sent = send_chunked(response);
+    BOOST_CHECK(sent.has("Content-Encoding: deflate"));
+    BOOST_CHECK(inflate(sent.body) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_chunks_coalesced)
+{
+    // Not compressible, the deflater emits its blocks as it goes.
+    std::string expected;
+    uint32_t seed = 42;
+    for (int i = 0; i < 256 * 1024; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        expected += char(seed >> 16);
+    }
+
+    size_t offset = 0;
+    Response response(
+        HttpCode::Ok,
+        [&]() -> std::string_view
+        {
+            auto size = std::min<size_t>(1024, expected.size() - offset);
+            std::string_view chunk(expected.data() + offset, size);
+            offset += size;
+            return chunk;
+        }
+    );
+    response.setChunkCoalescing(4096, std::chrono::seconds(10));
+    response.setContentCoding(ContentCoding::Gzip, {});
+    size_t writes = 0;
+    auto sent = send_chunked(response, &writes);
+    BOOST_CHECK(inflate(sent.body) == expected);
+    // The budget is spent on what the deflater produced, not all of the
+    // body in a single write.
+    BOOST_CHECK_GT(writes, 10u);
+    BOOST_TEST_MESSAGE("256KiB compressed in " << writes << " writes");
+}
+
+BOOST_AUTO_TEST_CASE(server_negotiates)
+{
+    HttpServer server;
+    server.setCompression();
+    server.start();
+    server.setSink(
+        [](Connection* connection)
+        {
+            connection->response()
+                .setCode(HttpCode::Ok)
+                .setBody(JSON)
+                .addHeader("Content-Type", "application/json");
+            connection->sendResponse();
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    boost::asio::streambuf buffer;
+
+    auto get = [&](const std::string& accept)
+    {
+        boost::asio::write(
+            s, boost::asio::buffer("GET / HTTP/1.1\r\nAccept-Encoding: " + accept + "\r\n\r\n")
+        );
+        return read_response(s, buffer);
+    };
+
+    auto gzip = get("gzip, deflate");
+    BOOST_CHECK(gzip.has("Content-Encoding: gzip"));
+    BOOST_CHECK(inflate(gzip.body) == JSON);
+
+    auto identity = get("identity");
+    BOOST_CHECK(identity.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(identity.body == JSON);
+
+    server.stop();
+}
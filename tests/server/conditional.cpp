@@ -0,0 +1,233 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+#include "httpp/http/RestDispatcher.hpp"
+#include "httpp/http/StaticResponse.hpp"
+
+#include "helpers.hpp"
+
+using namespace HTTPP;
+
+using HTTPP::HTTP::Connection;
+using HTTPP::HTTP::HTTP_DATE_SIZE;
+using HTTPP::HTTP::HttpCode;
+using HTTPP::HTTP::Response;
+
+BOOST_AUTO_TEST_CASE(parse_http_date)
+{
+    std::time_t time = 0;
+    BOOST_CHECK(HTTP::parse_http_date("Sun, 06 Nov 1994 08:49:37 GMT", time));
+    BOOST_CHECK_EQUAL(time, 784111777);
+
+    char date[HTTP_DATE_SIZE];
+    HTTP::format_http_date(1700000000, date);
+    BOOST_CHECK(HTTP::parse_http_date({date, HTTP_DATE_SIZE}, time));
+    BOOST_CHECK_EQUAL(time, 1700000000);
+
+    BOOST_CHECK(!HTTP::parse_http_date("", time));
+    BOOST_CHECK(!HTTP::parse_http_date("Sunday, 06-Nov-94 08:49:37 GMT", time));
+    BOOST_CHECK(!HTTP::parse_http_date("Sun Nov  6 08:49:37 1994", time));
+    BOOST_CHECK(!HTTP::parse_http_date("Sun, 06 Nov 1994 08:49:37 UTC", time));
+    BOOST_CHECK(!HTTP::parse_http_date("Sun, 06 Noc 1994 08:49:37 GMT", time));
+    BOOST_CHECK(!HTTP::parse_http_date("Sun, 06 Nov 1994 24:49:37 GMT", time));
+    BOOST_CHECK(!HTTP::parse_http_date("Sun, 0x Nov 1994 08:49:37 GMT", time));
+}
+
+BOOST_AUTO_TEST_CASE(preconditions)
+{
+    Response response;
+    BOOST_CHECK(!response.isNotModified("\"a\"", ""));
+    BOOST_CHECK(!response.isNotModified("", "Sun, 06 Nov 1994 08:49:37 GMT"));
+
+    response.setETag("v1");
+    BOOST_CHECK(response.isNotModified("\"v1\"", ""));
+    BOOST_CHECK(response.isNotModified("W/\"v1\"", ""));
+    BOOST_CHECK(response.isNotModified("\"v0\", \"v1\"", ""));
+    BOOST_CHECK(response.isNotModified("\"a,b\",\"v1\"", ""));
+    BOOST_CHECK(response.isNotModified("*", ""));
+    BOOST_CHECK(!response.isNotModified("\"v2\"", ""));
+    BOOST_CHECK(!response.isNotModified("\"v", ""));
+    BOOST_CHECK(!response.isNotModified("v1", ""));
+
+    response.setETag("v1", true);
+    BOOST_CHECK(response.isNotModified("\"v1\"", ""));
+    BOOST_CHECK_THROW(response.setETag("a\"b"), std::invalid_argument);
+
+    response.setLastModified(784111777);
+    BOOST_CHECK(response.isNotModified("", "Sun, 06 Nov 1994 08:49:37 GMT"));
+    BOOST_CHECK(response.isNotModified("", "Mon, 07 Nov 1994 08:49:37 GMT"));
+    BOOST_CHECK(!response.isNotModified("", "Sat, 05 Nov 1994 08:49:37 GMT"));
+    BOOST_CHECK(!response.isNotModified("", "yesterday"));
+    // If-None-Match wins
+    BOOST_CHECK(!response.isNotModified("\"v2\"", "Sun, 06 Nov 1994 08:49:37 GMT"));
+
+    response.clear();
+    BOOST_CHECK(!response.isNotModified("*", "Sun, 06 Nov 1994 08:49:37 GMT"));
+}
+
+BOOST_AUTO_TEST_CASE(not_modified_response)
+{
+    Response response(HttpCode::Ok, "the body");
+    response.setETag("v1", true).setLastModified(784111777).addHeader("Cache-Control", "max-age=60");
+
+    auto sent = serialize(response);
+    BOOST_CHECK(sent.find("\r\nETag: W/\"v1\"\r\n") != std::string::npos);
+    BOOST_CHECK(sent.find("\r\nLast-Modified: Sun, 06 Nov 1994 08:49:37 GMT\r\n") != std::string::npos);
+    BOOST_CHECK(sent.find("Content-Length: 8\r\n") != std::string::npos);
+
+    response.setNotModified();
+    sent = serialize(response);
+    BOOST_CHECK_EQUAL(sent.substr(0, sent.find("\r\n")), "HTTP/1.1 304 NotModified");
+    BOOST_CHECK(sent.find("\r\nETag: W/\"v1\"\r\n") != std::string::npos);
+    BOOST_CHECK(sent.find("\r\nCache-Control: max-age=60\r\n") != std::string::npos);
+    BOOST_CHECK(sent.find("Content-Length") == std::string::npos);
+    BOOST_CHECK_EQUAL(sent.substr(sent.size() - 4), "\r\n\r\n");
+
+    // A chunked body is dropped too
+    response.clear();
+    response.setBody([]() -> std::string_view { return {}; }).setNotModified();
+    BOOST_CHECK(!response.isChunked());
+    BOOST_CHECK(serialize(response).find("Transfer-Encoding") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(not_modified_varies)
+{
+    using HTTPP::HTTP::helper::ContentCoding;
+
+    // The full response would be compressed for this client
+    std::string body(4096, 'a');
+    Response response(HttpCode::Ok, body);
+    response.addHeader("Content-Type", "text/plain").setETag("v1").setNotModified();
+    response.setContentCoding(ContentCoding::Gzip, {});
+    auto sent = split(serialize(response));
+    BOOST_CHECK(sent.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(sent.has("ETag: \"v1-gzip\""));
+    BOOST_CHECK(sent.head.find("Content-Encoding") == std::string::npos);
+    BOOST_CHECK(sent.body.empty());
+
+    // and would vary for this one
+    response.setContentCoding(ContentCoding::Identity, {});
+    sent = split(serialize(response));
+    BOOST_CHECK(sent.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(sent.has("ETag: \"v1\""));
+
+    // A chunked body always varies
+    response.clear();
+    response.setBody([]() -> std::string_view { return {}; }).setNotModified();
+    response.setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(split(serialize(response)).has("Vary: Accept-Encoding"));
+
+    // Too small to be compressed
+    response.clear();
+    response.setBody("small").setNotModified();
+    response.setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(split(serialize(response)).head.find("Vary") == std::string::npos);
+
+    // Not compressible
+    response.clear();
+    response.setBody(body).addHeader("Content-Type", "image/png").setNotModified();
+    response.setContentCoding(ContentCoding::Gzip, {});
+    BOOST_CHECK(split(serialize(response)).head.find("Vary") == std::string::npos);
+}
+
+struct Client
+{
+    boost::asio::io_service io_service;
+    boost::asio::ip::tcp::socket s{connect(io_service)};
+    boost::asio::streambuf buffer;
+
+    // Head and body of the response to a GET of path
+    std::pair<std::string, std::string> get(const std::string& path, const std::string& headers = "")
+    {
+        boost::asio::write(s, boost::asio::buffer("GET " + path + " HTTP/1.1\r\n" + headers + "\r\n"));
+        auto sent = read_response(s, buffer);
+        return {sent.head, sent.body};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(server_fast_path)
+{
+    std::atomic_int built = {0};
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&built](Connection* connection)
+        {
+            connection->response().setETag("42").setLastModified(784111777);
+            if (connection->sendIfNotModified())
+            {
+                return;
+            }
+
+            ++built;
+            connection->response().setCode(HttpCode::Ok).setBody("expensive");
+            connection->sendResponse();
+        }
+    );
+    server.bind("localhost");
+
+    Client client;
+    auto [head, body] = client.get("/");
+    BOOST_CHECK(head.find("HTTP/1.1 200") == 0);
+    BOOST_CHECK(head.find("\r\nETag: \"42\"\r\n") != std::string::npos);
+    BOOST_CHECK_EQUAL(body, "expensive");
+    BOOST_CHECK_EQUAL(built, 1);
+
+    // The connection stays usable after the header-only responses.
+    for (auto conditional : {"If-None-Match: \"42\"\r\n", "If-Modified-Since: Sun, 06 Nov 1994 08:49:37 GMT\r\n"})
+    {
+        std::tie(head, body) = client.get("/", conditional);
+        BOOST_CHECK(head.find("HTTP/1.1 304") == 0);
+        BOOST_CHECK(head.find("\r\nETag: \"42\"\r\n") != std::string::npos);
+        BOOST_CHECK(body.empty());
+    }
+    BOOST_CHECK_EQUAL(built, 1);
+
+    std::tie(head, body) = client.get("/", "If-None-Match: \"41\"\r\n");
+    BOOST_CHECK(head.find("HTTP/1.1 200") == 0);
+    BOOST_CHECK_EQUAL(body, "expensive");
+    BOOST_CHECK_EQUAL(built, 2);
+
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(static_route)
+{
+    HttpServer server;
+    server.start();
+
+    HTTP::RestDispatcher dispatcher(server);
+    dispatcher.add<HTTP::Method::GET>(
+        "/status", std::make_shared<const HTTP::StaticResponse>(HttpCode::Ok, "{\"up\": true}")
+    );
+    server.bind("localhost");
+
+    Client client;
+    auto [head, body] = client.get("/status");
+    auto etag = head.find("\r\nETag: ");
+    BOOST_REQUIRE(etag != std::string::npos);
+    auto value = head.substr(etag + 8, head.find("\r\n", etag + 2) - etag - 8);
+    BOOST_CHECK_EQUAL(body, "{\"up\": true}");
+
+    std::tie(head, body) = client.get("/status", "If-None-Match: " + value + "\r\n");
+    BOOST_CHECK(head.find("HTTP/1.1 304") == 0);
+    BOOST_CHECK(body.empty());
+
+    server.stop();
+}
@@ -0,0 +1,117 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+
+using namespace HTTPP;
+
+using HTTPP::HTTP::Connection;
+
+static const std::string REQUEST =
+    "GET / HTTP/1.1\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+
+static const std::string BODY(16 * 1024, 'x');
+
+struct Recorder : EventHandler
+{
+    void connection_created(Connection* connection) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++created;
+        seen.insert(connection);
+    }
+
+    void connection_destroyed(Connection*) override
+    {
+    }
+
+    void response_send(Connection*) override
+    {
+    }
+
+    std::mutex mutex;
+    size_t created = 0;
+    std::set<Connection*> seen;
+};
+
+void handler(Connection* connection)
+{
+    connection->response()
+        .setCode(HTTP::HttpCode::Ok)
+        .setBody(BODY)
+        .connectionShouldBeClosed(true);
+    connection->sendResponse();
+}
+
+static void run_requests(size_t nb)
+{
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::resolver resolver(io_service);
+
+    for (size_t i = 0; i < nb; ++i)
+    {
+        tcp::socket s(io_service);
+        boost::asio::connect(s, resolver.resolve({"localhost", "8000"}));
+        boost::asio::write(s, boost::asio::buffer(REQUEST));
+
+        boost::asio::streambuf b;
+        boost::system::error_code ec;
+        boost::asio::read(s, b, ec);
+        BOOST_REQUIRE(ec == boost::asio::error::eof);
+
+        std::string response(
+            boost::asio::buffers_begin(b.data()), boost::asio::buffers_end(b.data())
+        );
+        BOOST_CHECK(boost::starts_with(response, "HTTP/1.1 200 Ok\r\n"));
+        BOOST_CHECK(boost::ends_with(response, "\r\n\r\n" + BODY));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(connections_are_reused)
+{
+    Recorder recorder;
+    HttpServer server;
+    server.eventHandler(recorder);
+    server.start();
+    server.setSink(&handler);
+    server.bind("localhost");
+
+    run_requests(20);
+
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    BOOST_CHECK_GE(recorder.created, 20u);
+    BOOST_CHECK_LT(recorder.seen.size(), recorder.created);
+}
+
+BOOST_AUTO_TEST_CASE(pool_disabled)
+{
+    Recorder recorder;
+    HttpServer server;
+    server.setConnectionPool(0, 0);
+    server.eventHandler(recorder);
+    server.start();
+    server.setSink(&handler);
+    server.bind("localhost");
+
+    run_requests(5);
+    BOOST_CHECK_GE(recorder.created, 5u);
+}
@@ -0,0 +1,214 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+
+#include "helpers.hpp"
+
+using namespace HTTPP;
+
+using HTTPP::HTTP::Connection;
+using HTTPP::HTTP::HttpCode;
+using HTTPP::HTTP::Response;
+
+static const std::string CONTENT = []
+{
+    std::string s;
+    s.reserve(1024 * 1024);
+    for (size_t i = 0; s.size() < 1024 * 1024; ++i)
+    {
+        s += std::to_string(i);
+        s += ' ';
+    }
+    s.resize(1024 * 1024);
+    return s;
+}();
+
+struct TemporaryFile
+{
+    TemporaryFile()
+    {
+        std::ofstream(path, std::ios::binary) << CONTENT;
+    }
+
+    ~TemporaryFile()
+    {
+        std::remove(path.c_str());
+    }
+
+    std::string path = "/tmp/httpp_file_body_" + std::to_string(::getpid());
+};
+
+static TemporaryFile file;
+
+static void handler(Connection* connection)
+{
+    connection->response().setBodyFile(
+        file.path, connection->request().header(HTTP::HeaderId::Range)
+    );
+    connection->sendResponse();
+}
+
+BOOST_AUTO_TEST_CASE(sendfile_ranges)
+{
+    HttpServer server;
+    server.start();
+    server.setSink(&handler);
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    boost::asio::streambuf buffer;
+
+    auto get = [&](const std::string& range)
+    {
+        std::string request = "GET /file HTTP/1.1\r\n";
+        if (!range.empty())
+        {
+            request += "Range: " + range + "\r\n";
+        }
+        request += "\r\n";
+        boost::asio::write(s, boost::asio::buffer(request));
+        return read_response(s, buffer);
+    };
+
+    auto whole = get("");
+    BOOST_CHECK_EQUAL(whole.head.substr(0, 17), "HTTP/1.1 200 Ok\r\n");
+    BOOST_CHECK(whole.has("Accept-Ranges: bytes"));
+    BOOST_CHECK(whole.body == CONTENT);
+
+    auto part = get("bytes=100-199");
+    BOOST_CHECK_EQUAL(part.head.substr(0, 29), "HTTP/1.1 206 PartialContent\r\n");
+    BOOST_CHECK(part.has("Content-Range: bytes 100-199/1048576"));
+    BOOST_CHECK_EQUAL(part.body, CONTENT.substr(100, 100));
+
+    auto tail = get("bytes=-10");
+    BOOST_CHECK(tail.has("Content-Range: bytes 1048566-1048575/1048576"));
+    BOOST_CHECK_EQUAL(tail.body, CONTENT.substr(CONTENT.size() - 10));
+
+    auto resume = get("bytes=1000000-");
+    BOOST_CHECK_EQUAL(resume.body, CONTENT.substr(1000000));
+
+    auto clamped = get("bytes=1048570-2000000");
+    BOOST_CHECK_EQUAL(clamped.body, CONTENT.substr(1048570));
+
+    auto past_end = get("bytes=2000000-");
+    BOOST_CHECK_EQUAL(
+        past_end.head.substr(0, 43), "HTTP/1.1 416 RequestedRangeNotSatisfiable\r\n"
+    );
+    BOOST_CHECK(past_end.has("Content-Range: bytes */1048576"));
+    BOOST_CHECK(past_end.body.empty());
+
+    // Several ranges or an invalid one are answered with the whole file
+    BOOST_CHECK(get("bytes=0-1,5-6").body == CONTENT);
+    BOOST_CHECK(get("bytes=20-10").body == CONTENT);
+    BOOST_CHECK(get("items=0-10").body == CONTENT);
+
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(pread_fallback)
+{
+    // A stream that is not a socket is written with pread(2).
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+
+    boost::asio::io_context io;
+    boost::asio::posix::stream_descriptor input(io, fds[0]);
+    boost::asio::posix::stream_descriptor output(io, fds[1]);
+
+    Response response;
+    response.setBodyFile(file.path, "bytes=1000-");
+
+    boost::system::error_code write_ec = boost::asio::error::would_block;
+    response.sendResponse(
+        output,
+        [&](const boost::system::error_code& ec, size_t)
+        {
+            write_ec = ec;
+            output.close();
+        }
+    );
+
+    std::string received;
+    boost::system::error_code read_ec;
+    boost::asio::async_read(
+        input,
+        boost::asio::dynamic_buffer(received),
+        [&](const boost::system::error_code& ec, size_t)
+        {
+            read_ec = ec;
+        }
+    );
+    io.run();
+
+    BOOST_CHECK(!write_ec);
+    BOOST_CHECK(read_ec == boost::asio::error::eof);
+    auto head_end = received.find("\r\n\r\n");
+    BOOST_REQUIRE(head_end != std::string::npos);
+    BOOST_CHECK(received.substr(head_end + 4) == CONTENT.substr(1000));
+    BOOST_CHECK(!response.hasBodyFile());
+}
+
+BOOST_AUTO_TEST_CASE(sendfile_blocking_mode)
+{
+    // The socket is only made non-blocking while sendfile(2) runs.
+    boost::asio::io_context io;
+    boost::asio::local::stream_protocol::socket input(io);
+    boost::asio::local::stream_protocol::socket output(io);
+    boost::asio::local::connect_pair(input, output);
+    BOOST_REQUIRE(!output.native_non_blocking());
+
+    Response response;
+    response.setBodyFile(file.path);
+
+    boost::system::error_code write_ec = boost::asio::error::would_block;
+    bool non_blocking = true;
+    response.sendResponse(
+        output,
+        [&](const boost::system::error_code& ec, size_t)
+        {
+            write_ec = ec;
+            non_blocking = output.native_non_blocking();
+            output.close();
+        }
+    );
+
+    std::string received;
+    boost::asio::async_read(
+        input,
+        boost::asio::dynamic_buffer(received),
+        [](const boost::system::error_code&, size_t) {}
+    );
+    io.run();
+
+    BOOST_CHECK(!write_ec);
+    BOOST_CHECK(!non_blocking);
+    auto head_end = received.find("\r\n\r\n");
+    BOOST_REQUIRE(head_end != std::string::npos);
+    BOOST_CHECK(received.substr(head_end + 4) == CONTENT);
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+    Response response;
+    BOOST_CHECK_THROW(response.setBodyFile("/nonexistent/httpp"), std::system_error);
+    BOOST_CHECK_THROW(response.setBodyFile("/tmp"), std::system_error);
+}
@@ -0,0 +1,197 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#ifndef HTTPP_TESTS_SERVER_HELPERS_HPP_
+#define HTTPP_TESTS_SERVER_HELPERS_HPP_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/http/Response.hpp"
+#include "httpp/http/helper/ChunkedDecoder.hpp"
+
+// A response as the client gets it
+struct Sent
+{
+    std::string head;
+    std::string body;
+
+    // Whether the head has this whole header line
+    bool has(const std::string& line) const
+    {
+        return head.find("\r\n" + line + "\r\n") != std::string::npos;
+    }
+};
+
+// Cut a whole response after its empty line
+inline Sent split(const std::string& response)
+{
+    auto end = response.find("\r\n\r\n");
+    BOOST_REQUIRE(end != std::string::npos);
+    return {response.substr(0, end + 2), response.substr(end + 4)};
+}
+
+inline std::string serialize(HTTPP::HTTP::Response& response)
+{
+    std::vector<char> out;
+    response.serialize(out);
+    return std::string(out.begin(), out.end());
+}
+
+// Decode gzip or zlib data
+inline std::string inflate(std::string_view data)
+{
+    z_stream z = {};
+    BOOST_REQUIRE_EQUAL(inflateInit2(&z, 15 + 32), Z_OK);
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    z.avail_in = uInt(data.size());
+
+    std::string out;
+    int result = Z_OK;
+    while (result == Z_OK)
+    {
+        char buffer[16384];
+        z.next_out = reinterpret_cast<Bytef*>(buffer);
+        z.avail_out = sizeof(buffer);
+        result = ::inflate(&z, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - z.avail_out);
+        if (result == Z_BUF_ERROR && z.avail_in == 0)
+        {
+            break;
+        }
+    }
+    BOOST_CHECK_EQUAL(result, Z_STREAM_END);
+    inflateEnd(&z);
+    return out;
+}
+
+// The payload of a whole chunked body
+inline std::string decode_chunked(std::string_view chunked)
+{
+    const char* data = chunked.data();
+    const char* end = data + chunked.size();
+    HTTPP::HTTP::helper::ChunkedDecoder decoder;
+    std::string body;
+    std::string_view chunk;
+    HTTPP::HTTP::helper::ChunkedDecoder::Status status;
+    while ((status = decoder.decode(data, end, chunk)) == HTTPP::HTTP::helper::ChunkedDecoder::Status::Data)
+    {
+        body.append(chunk);
+    }
+    BOOST_CHECK(status == HTTPP::HTTP::helper::ChunkedDecoder::Status::Done);
+    BOOST_CHECK(data == end);
+    return body;
+}
+
+inline boost::asio::ip::tcp::socket connect(boost::asio::io_service& io_service)
+{
+    boost::asio::ip::tcp::socket s(io_service);
+    boost::asio::ip::tcp::resolver resolver(io_service);
+    boost::asio::connect(s, resolver.resolve({"localhost", "8000"}));
+    return s;
+}
+
+// Read the next response, its body is Content-Length bytes long or empty.
+// buffer keeps what has been read past it.
+template <typename Stream>
+Sent read_response(Stream& stream, boost::asio::streambuf& buffer)
+{
+    auto size = boost::asio::read_until(stream, buffer, "\r\n\r\n");
+    Sent sent;
+    sent.head.resize(size);
+    buffer.sgetn(sent.head.data(), size);
+
+    size_t length = 0;
+    auto pos = sent.head.find("Content-Length: ");
+    if (pos != std::string::npos)
+    {
+        length = std::stoul(sent.head.substr(pos + 16));
+    }
+
+    if (buffer.size() < length)
+    {
+        boost::asio::read(stream, buffer, boost::asio::transfer_exactly(length - buffer.size()));
+    }
+
+    sent.body.resize(length);
+    buffer.sgetn(sent.body.data(), length);
+    return sent;
+}
+
+// Counts the writes made to the stream it wraps
+struct CountingWriter
+{
+    using executor_type = boost::asio::posix::stream_descriptor::executor_type;
+
+    executor_type get_executor()
+    {
+        return next.get_executor();
+    }
+
+    template <typename Buffers, typename Handler>
+    void async_write_some(const Buffers& buffers, Handler&& handler)
+    {
+        ++writes;
+        next.async_write_some(buffers, std::forward<Handler>(handler));
+    }
+
+    boost::asio::posix::stream_descriptor& next;
+    size_t writes = 0;
+};
+
+// Send a chunked response through a pipe, its body is decoded. writes is
+// the number of writes it took.
+inline Sent send_chunked(HTTPP::HTTP::Response& response, size_t* writes = nullptr)
+{
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+    // Large enough that a write is never cut in several by the pipe
+    ::fcntl(fds[1], F_SETPIPE_SZ, 1024 * 1024);
+
+    boost::asio::io_context io;
+    boost::asio::posix::stream_descriptor input(io, fds[0]);
+    boost::asio::posix::stream_descriptor output(io, fds[1]);
+    CountingWriter writer{output};
+
+    boost::system::error_code write_ec = boost::asio::error::would_block;
+    response.sendResponse(
+        writer,
+        [&](const boost::system::error_code& ec, size_t)
+        {
+            write_ec = ec;
+            output.close();
+        }
+    );
+
+    std::string received;
+    boost::asio::async_read(
+        input, boost::asio::dynamic_buffer(received), [](const boost::system::error_code&, size_t) {}
+    );
+    io.run();
+    BOOST_CHECK(!write_ec);
+    if (writes)
+    {
+        *writes = writer.writes;
+    }
+
+    auto sent = split(received);
+    sent.body = decode_chunked(sent.body);
+    return sent;
+}
+
+#endif // !HTTPP_TESTS_SERVER_HELPERS_HPP_
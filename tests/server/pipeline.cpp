@@ -8,10 +8,15 @@
  *
  */
 
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <istream>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/asio.hpp>
@@ -22,6 +27,8 @@
 #include "httpp/http/Connection.hpp"
 #include "httpp/utils/Exception.hpp"
 
+#include "helpers.hpp"
+
 using namespace HTTPP;
 
 using HTTPP::HTTP::Connection;
@@ -189,3 +196,363 @@ BOOST_AUTO_TEST_CASE(pipeline_with_body)
 
     BOOST_CHECK_EQUAL(total_size, BODY.size() * 3);
 }
+
+// Read until count responses without body have been received, returns the
+// number of reads it took.
+static size_t read_responses(
+    boost::asio::ip::tcp::socket& s, size_t count, std::string* received = nullptr
+)
+{
+    std::string pending;
+    char buffer[65536];
+    size_t reads = 0;
+    while (count)
+    {
+        auto n = s.read_some(boost::asio::buffer(buffer));
+        ++reads;
+        pending.append(buffer, n);
+        if (received)
+        {
+            received->append(buffer, n);
+        }
+
+        size_t pos = 0, end;
+        while (count && (end = pending.find("\r\n\r\n", pos)) != std::string::npos)
+        {
+            --count;
+            pos = end + 4;
+        }
+        pending.erase(0, pos);
+    }
+    return reads;
+}
+
+void handler_echo(Connection* connection)
+{
+    const auto& request = connection->request();
+    connection->response()
+        .setCode(HTTP::HttpCode::Ok)
+        .addHeader("X-Uri", std::string(request.uri) + "=" + to_string(request.queryParam("a")))
+        .setBody("");
+    connection->sendResponse();
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_split_anywhere)
+{
+    HttpServer server;
+    server.start();
+    server.setSink(&handler_echo);
+    server.bind("localhost");
+
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::socket s(io_service);
+    tcp::resolver resolver(io_service);
+    boost::asio::connect(s, resolver.resolve({"localhost", "8000"}));
+    s.set_option(tcp::no_delay(true));
+
+    // More than the read buffer holds, sent in pieces that cut requests
+    // in the middle: what is left of a request is moved to the front of
+    // the buffer while it is being parsed.
+    std::string requests;
+    const size_t count = 500;
+    for (size_t i = 0; i < count; ++i)
+    {
+        requests += "GET /split/" + std::to_string(i) + "?a=" + std::to_string(i)
+                    + " HTTP/1.1\r\nHost: localhost\r\nX-Padding: " + std::string(i % 37, 'p')
+                    + "\r\n\r\n";
+    }
+
+    size_t sent = 0, piece = 1;
+    while (sent < requests.size())
+    {
+        piece = piece * 7 % 1499 + 1;
+        auto n = std::min(piece, requests.size() - sent);
+        boost::asio::write(s, boost::asio::buffer(requests.data() + sent, n));
+        sent += n;
+    }
+
+    std::string received;
+    read_responses(s, count, &received);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto expected = "X-Uri: /split/" + std::to_string(i) + "=" + std::to_string(i) + "\r\n";
+        auto found = received.find(expected, pos);
+        BOOST_REQUIRE_MESSAGE(found != std::string::npos, "Missing response " << i);
+        pos = found + expected.size();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_shared_bodies)
+{
+    // Larger than what is copied to the pipelined responses
+    auto shared = std::make_shared<const std::string>(100000, 's');
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&shared](Connection* connection)
+        {
+            auto& response = connection->response().setCode(HTTP::HttpCode::Ok);
+            response.setBody(std::string(connection->request().uri))
+                .appendBody({boost::asio::buffer(*shared), shared});
+            connection->sendResponse();
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    std::string requests;
+    for (int i = 0; i < 8; ++i)
+    {
+        requests += "GET /" + std::to_string(i) + " HTTP/1.1\r\n\r\n";
+    }
+    boost::asio::write(s, boost::asio::buffer(requests));
+
+    boost::asio::streambuf buffer;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto sent = read_response(s, buffer);
+        BOOST_CHECK(sent.body == "/" + std::to_string(i) + *shared);
+    }
+
+    server.stop();
+}
+
+// The first request is answered right away, the second one by second_handler
+// that may defer it: the first response must not wait for it. The handler
+// returns the connection to answer later, if any, the second body is then
+// second_body.
+static void check_held_response(
+    const std::string& second,
+    std::function<Connection*(Connection*)> second_handler,
+    const std::string& second_body
+)
+{
+    std::promise<Connection*> deferred;
+    HttpServer server;
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            if (connection->request().uri == second)
+            {
+                deferred.set_value(second_handler(connection));
+                return;
+            }
+
+            connection->response().setCode(HTTP::HttpCode::Ok).setBody("early");
+            connection->sendResponse();
+        }
+    );
+    server.bind("localhost");
+
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::socket s(io_service);
+    tcp::resolver resolver(io_service);
+    boost::asio::connect(s, resolver.resolve({"localhost", "8000"}));
+    boost::asio::write(
+        s, boost::asio::buffer("GET /early HTTP/1.1\r\n\r\nGET " + second + " HTTP/1.1\r\n\r\n")
+    );
+
+    std::string received;
+    auto read_until = [&](const std::string& delim)
+    {
+        io_service.restart();
+        boost::asio::async_read_until(
+            s, boost::asio::dynamic_buffer(received), delim, [](const boost::system::error_code&, size_t) {}
+        );
+        io_service.run_for(std::chrono::seconds(2));
+        return received.find(delim) != std::string::npos;
+    };
+
+    BOOST_CHECK(read_until("\r\n\r\nearly"));
+    auto connection = deferred.get_future().get();
+    if (connection)
+    {
+        connection->response().setCode(HTTP::HttpCode::Ok).setBody(second_body);
+        connection->sendResponse();
+    }
+
+    if (!second_body.empty())
+    {
+        BOOST_CHECK(read_until("\r\n\r\n" + second_body));
+    }
+
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_late_response)
+{
+    check_held_response("/late", [](Connection* connection) { return connection; }, "late");
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_response_from_another_thread)
+{
+    // Sent before the handler returns
+    check_held_response(
+        "/thread",
+        [](Connection* connection) -> Connection*
+        {
+            std::thread(
+                [connection]
+                {
+                    connection->response().setCode(HTTP::HttpCode::Ok).setBody("thread");
+                    connection->sendResponse();
+                }
+            ).join();
+            return nullptr;
+        },
+        "thread"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_released_by_handler)
+{
+    check_held_response(
+        "/release",
+        [](Connection* connection) -> Connection*
+        {
+            Connection::releaseFromHandler(connection);
+            return nullptr;
+        },
+        ""
+    );
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_responses_racing_dispatch)
+{
+    // Each response is sent from the I/O thread, from another thread while
+    // the handler is still running, or from another thread after it
+    // returned: the held responses must go out once and in order whatever
+    // the interleaving.
+    std::mutex threads_mutex;
+    std::vector<std::thread> threads;
+    std::atomic_int calls = {0};
+    HttpServer server(2);
+    server.start();
+    server.setSink(
+        [&](Connection* connection)
+        {
+            auto body = std::string(connection->request().uri);
+            auto respond = [connection, body]
+            {
+                connection->response().setCode(HTTP::HttpCode::Ok).setBody(body);
+                connection->sendResponse();
+            };
+
+            switch (calls++ % 3)
+            {
+            case 0:
+                respond();
+                break;
+            case 1:
+            {
+                std::thread racing(respond);
+                std::this_thread::yield();
+                std::lock_guard<std::mutex> lock(threads_mutex);
+                threads.push_back(std::move(racing));
+                break;
+            }
+            default:
+                std::lock_guard<std::mutex> lock(threads_mutex);
+                threads.emplace_back(
+                    [respond]
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                        respond();
+                    }
+                );
+            }
+        }
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    s.set_option(boost::asio::ip::tcp::no_delay(true));
+    boost::asio::streambuf buffer;
+    for (int round = 0; round < 20; ++round)
+    {
+        std::string requests;
+        for (int i = 0; i < 5; ++i)
+        {
+            requests += "GET /" + std::to_string(round) + "/" + std::to_string(i) + " HTTP/1.1\r\n\r\n";
+        }
+        boost::asio::write(s, boost::asio::buffer(requests));
+
+        for (int i = 0; i < 5; ++i)
+        {
+            auto sent = read_response(s, buffer);
+            BOOST_REQUIRE_EQUAL(sent.body, "/" + std::to_string(round) + "/" + std::to_string(i));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    server.stop();
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_pipelined_throughput)
+{
+    HttpServer server;
+    server.start();
+    server.setSink(&handler);
+    server.bind("localhost");
+
+    using Clock = std::chrono::steady_clock;
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::socket s(io_service);
+    tcp::resolver resolver(io_service);
+    boost::asio::connect(s, resolver.resolve({"localhost", "8000"}));
+    s.set_option(tcp::no_delay(true));
+
+    const size_t batch = 64;
+    const size_t rounds = 50;
+    std::string requests;
+    for (size_t i = 0; i < batch; ++i)
+    {
+        requests += "GET /bench HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    }
+
+    size_t reads = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        boost::asio::write(s, boost::asio::buffer(requests));
+        reads += read_responses(s, batch);
+    }
+    auto pipelined = Clock::now() - start;
+
+    const std::string one = "GET /bench HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    start = Clock::now();
+    for (size_t i = 0; i < rounds * batch / 4; ++i)
+    {
+        boost::asio::write(s, boost::asio::buffer(one));
+        read_responses(s, 1);
+    }
+    auto sequential = Clock::now() - start;
+
+    // The responses to a batch are written together
+    BOOST_CHECK_LT(reads, rounds * batch);
+
+    auto rate = [](size_t n, Clock::duration d)
+    {
+        return n / std::chrono::duration<double>(d).count();
+    };
+
+    BOOST_TEST_MESSAGE(
+        "Pipelined: " << rate(rounds * batch, pipelined) << " requests/s, "
+                      << double(reads) / rounds << " reads for " << batch << " responses"
+    );
+    BOOST_TEST_MESSAGE("One at a time: " << rate(rounds * batch / 4, sequential) << " requests/s");
+}
@@ -0,0 +1,149 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/http/Protocol.hpp"
+#include "httpp/http/Response.hpp"
+
+#include "helpers.hpp"
+
+using HTTPP::HTTP::HttpCode;
+using HTTPP::HTTP::Response;
+
+BOOST_AUTO_TEST_CASE(status_lines)
+{
+    BOOST_CHECK_EQUAL(HTTPP::HTTP::status_line(HttpCode::Ok), "HTTP/1.1 200 Ok\r\n");
+    BOOST_CHECK_EQUAL(HTTPP::HTTP::status_line(HttpCode::NotFound), "HTTP/1.1 404 NotFound\r\n");
+    BOOST_CHECK_EQUAL(
+        HTTPP::HTTP::status_line(HttpCode::HttpVersionNotSupported),
+        "HTTP/1.1 505 HttpVersionNotSupported\r\n"
+    );
+    BOOST_CHECK(HTTPP::HTTP::status_line(HttpCode(299)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(serialized_response)
+{
+    Response response(HttpCode::Created, "body");
+    response.addHeader("Content-Type", "text/plain").addHeader("X-Custom", "value");
+    BOOST_CHECK_EQUAL(
+        serialize(response),
+        "HTTP/1.1 201 Created\r\n"
+        "Content-Type: text/plain\r\n"
+        "X-Custom: value\r\n"
+        "Content-Length: 4\r\n"
+        "\r\n"
+        "body"
+    );
+
+    // The buffer is reused for the next response
+    response.clear();
+    response.setCode(HttpCode(299));
+    BOOST_CHECK_EQUAL(serialize(response), "HTTP/1.1 299 Unknown\r\nContent-Length: 0\r\n\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(http_date)
+{
+    char date[HTTPP::HTTP::HTTP_DATE_SIZE];
+    HTTPP::HTTP::format_http_date(784111777, date);
+    BOOST_CHECK_EQUAL(std::string(date, sizeof(date)), "Sun, 06 Nov 1994 08:49:37 GMT");
+
+    auto line = HTTPP::HTTP::date_header();
+    BOOST_CHECK_EQUAL(line.size(), 6 + HTTPP::HTTP::HTTP_DATE_SIZE + 2);
+    BOOST_CHECK_EQUAL(line.substr(0, 6), "Date: ");
+    BOOST_CHECK_EQUAL(line.substr(line.size() - 5), "GMT\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(default_headers)
+{
+    Response response(HttpCode::Ok, "ok");
+    response.setDefaultHeaders(true, "Server: httpp\r\n");
+    auto date = std::string(HTTPP::HTTP::date_header());
+    auto serialized = serialize(response);
+    if (serialized.find(date) == std::string::npos)
+    {
+        // The second changed in between
+        date = std::string(HTTPP::HTTP::date_header());
+    }
+
+    BOOST_CHECK_EQUAL(
+        serialized,
+        "HTTP/1.1 200 Ok\r\n" + date + "Server: httpp\r\nContent-Length: 2\r\n\r\nok"
+    );
+
+    // Kept by clear(), but not added over the ones set by the handler.
+    response.clear();
+    response.addHeader("server", "custom").addHeader("Date", "Thu, 01 Jan 1970 00:00:00 GMT");
+    BOOST_CHECK_EQUAL(
+        serialize(response),
+        "HTTP/1.1 200 Ok\r\n"
+        "server: custom\r\n"
+        "Date: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(body_not_copied)
+{
+    auto shared = std::make_shared<const std::string>("shared");
+    Response response(HttpCode::Ok);
+    response.setBody(shared);
+    BOOST_CHECK_EQUAL(shared.use_count(), 2);
+    BOOST_CHECK(response.body().empty());
+    BOOST_CHECK_EQUAL(serialize(response), "HTTP/1.1 200 Ok\r\nContent-Length: 6\r\n\r\nshared");
+
+    std::string moved(1024, 'm');
+    response.setBody(std::move(moved));
+    BOOST_CHECK_EQUAL(shared.use_count(), 1);
+    BOOST_CHECK_EQUAL(response.bodySize(), 1024);
+
+    std::vector<char> vector = {'v', 'e', 'c'};
+    auto data = vector.data();
+    response.setBody(std::move(vector));
+    BOOST_CHECK(response.body().data() == data);
+
+    static const char SEGMENT[] = "segment";
+    response.appendBody({boost::asio::buffer(SEGMENT, 7), nullptr})
+        .appendBody({boost::asio::buffer(*shared), shared});
+    BOOST_CHECK_EQUAL(shared.use_count(), 2);
+    BOOST_CHECK_EQUAL(
+        serialize(response), "HTTP/1.1 200 Ok\r\nContent-Length: 16\r\n\r\nvecsegmentshared"
+    );
+
+    response.clear();
+    BOOST_CHECK_EQUAL(shared.use_count(), 1);
+    BOOST_CHECK_EQUAL(response.bodySize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(queued_segments_not_copied)
+{
+    auto shared = std::make_shared<const std::string>("shared");
+    Response response(HttpCode::Ok, "copied");
+    response.appendBody({boost::asio::buffer(*shared), shared});
+
+    // Queued after another response
+    std::vector<char> out = {'x'};
+    std::vector<Response::QueuedSegment> segments;
+    response.serialize(out, segments);
+    response.clear();
+
+    const std::string head = "xHTTP/1.1 200 Ok\r\nContent-Length: 12\r\n\r\ncopied";
+    BOOST_CHECK_EQUAL(std::string(out.begin(), out.end()), head);
+    BOOST_REQUIRE_EQUAL(segments.size(), 1u);
+    BOOST_CHECK_EQUAL(segments[0].offset, head.size());
+    BOOST_CHECK(segments[0].segment.data.data() == shared->data());
+    // The queue keeps it alive
+    BOOST_CHECK_EQUAL(shared.use_count(), 2);
+}
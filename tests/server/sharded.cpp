@@ -0,0 +1,125 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/Connection.hpp"
+
+using namespace HTTPP;
+
+using HTTPP::HTTP::Connection;
+
+static const std::string REQUEST =
+    "GET / HTTP/1.1\r\n"
+    "Host: localhost:8000\r\n"
+    "\r\n";
+
+static std::mutex threads_mutex;
+static std::map<Connection*, std::vector<std::thread::id>> threads;
+
+void handler(Connection* connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        threads[connection].push_back(std::this_thread::get_id());
+    }
+
+    connection->response().setCode(HTTP::HttpCode::Ok).setBody("");
+    connection->sendResponse();
+}
+
+static std::string read_status_line(boost::asio::ip::tcp::socket& s)
+{
+    boost::asio::streambuf b;
+    boost::asio::read_until(s, b, "\r\n\r\n");
+    std::istream is(&b);
+    std::string line;
+    std::getline(is, line);
+    boost::trim(line);
+    return line;
+}
+
+BOOST_AUTO_TEST_CASE(sharded_accept)
+{
+    HttpServer server(4, HttpServer::Sharded{});
+    server.start();
+    server.setSink(&handler);
+    server.bind("localhost");
+
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::resolver resolver(io_service);
+
+    std::vector<tcp::socket> sockets;
+    for (int i = 0; i < 16; ++i)
+    {
+        sockets.emplace_back(io_service);
+        boost::asio::connect(sockets.back(), resolver.resolve({"localhost", "8000"}));
+    }
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (auto& s : sockets)
+        {
+            boost::asio::write(s, boost::asio::buffer(REQUEST));
+            BOOST_CHECK_EQUAL(read_status_line(s), "HTTP/1.1 200 Ok");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(threads_mutex);
+    BOOST_CHECK_EQUAL(threads.size(), sockets.size());
+    for (const auto& conn : threads)
+    {
+        BOOST_REQUIRE_EQUAL(conn.second.size(), 3u);
+        // A connection never leaves the shard which accepted it.
+        BOOST_CHECK(conn.second[0] == conn.second[1]);
+        BOOST_CHECK(conn.second[0] == conn.second[2]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sharded_ephemeral_port)
+{
+    HttpServer server(4, HttpServer::Sharded{});
+    server.start();
+    server.setSink(&handler);
+    server.bind("127.0.0.1", "0");
+
+    // Every shard listens on the port the system gave to the first one
+    auto endpoints = server.getListeningEndpoints();
+    BOOST_REQUIRE_EQUAL(endpoints.size(), 4u);
+    auto port = endpoints.front().port();
+    BOOST_CHECK_NE(port, 0);
+    for (const auto& endpoint : endpoints)
+    {
+        BOOST_CHECK_EQUAL(endpoint.port(), port);
+    }
+
+    using boost::asio::ip::tcp;
+    boost::asio::io_service io_service;
+    tcp::endpoint endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port);
+    for (int i = 0; i < 16; ++i)
+    {
+        tcp::socket s(io_service);
+        s.connect(endpoint);
+        boost::asio::write(s, boost::asio::buffer(REQUEST));
+        BOOST_CHECK_EQUAL(read_status_line(s), "HTTP/1.1 200 Ok");
+    }
+
+    server.stop();
+}
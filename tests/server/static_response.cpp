@@ -0,0 +1,207 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/HttpServer.hpp"
+#include "httpp/http/RestDispatcher.hpp"
+#include "httpp/http/Request.hpp"
+#include "httpp/http/Response.hpp"
+#include "httpp/http/StaticResponse.hpp"
+
+#include "helpers.hpp"
+
+using namespace HTTPP;
+using namespace std::string_literals;
+
+using HTTPP::HTTP::HttpCode;
+using HTTPP::HTTP::Request;
+using HTTPP::HTTP::Response;
+using HTTPP::HTTP::StaticResponse;
+using HTTPP::HTTP::helper::ContentCoding;
+using HTTPP::HTTP::helper::negotiate_coding;
+
+static const std::string PAGE = []
+{
+    std::string s = "<html><body>";
+    for (int i = 0; i < 500; ++i)
+    {
+        s += "<p class=\"item\">Item " + std::to_string(i) + "</p>";
+    }
+    return s + "</body></html>";
+}();
+
+BOOST_AUTO_TEST_CASE(brotli_negotiation)
+{
+    BOOST_CHECK(negotiate_coding("gzip, deflate, br") == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("gzip, deflate, br", true) == ContentCoding::Brotli);
+    BOOST_CHECK(negotiate_coding("br;q=0.5, gzip", true) == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("br", false) == ContentCoding::Identity);
+    BOOST_CHECK(negotiate_coding("*", true) == ContentCoding::Brotli);
+
+    // The best of the variants there are, not the best one overall
+    HTTP::helper::AvailableCodings gzip_only = {true, true, false, false};
+    BOOST_CHECK(negotiate_coding("deflate, gzip;q=0.5", gzip_only) == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("br, deflate;q=0.8, gzip;q=0.5", gzip_only) == ContentCoding::Gzip);
+    BOOST_CHECK(negotiate_coding("deflate", gzip_only) == ContentCoding::Identity);
+    BOOST_CHECK(negotiate_coding("*;q=0.2, gzip;q=0", gzip_only) == ContentCoding::Identity);
+    HTTP::helper::AvailableCodings deflate_only = {true, false, true, false};
+    BOOST_CHECK(negotiate_coding("*", deflate_only) == ContentCoding::Deflate);
+}
+
+BOOST_AUTO_TEST_CASE(variants)
+{
+    StaticResponse page(HttpCode::Ok, PAGE, {{"Content-Type", "text/html"}});
+    BOOST_REQUIRE(page.body(ContentCoding::Identity));
+    BOOST_CHECK(*page.body(ContentCoding::Identity) == PAGE);
+    BOOST_REQUIRE(page.body(ContentCoding::Gzip));
+    BOOST_REQUIRE(page.body(ContentCoding::Deflate));
+    BOOST_CHECK_LT(page.body(ContentCoding::Gzip)->size(), PAGE.size() / 4);
+    BOOST_CHECK(inflate(*page.body(ContentCoding::Gzip)) == PAGE);
+    BOOST_CHECK(inflate(*page.body(ContentCoding::Deflate)) == PAGE);
+#if HTTPP_WITH_BROTLI
+    BOOST_REQUIRE(page.body(ContentCoding::Brotli));
+    BOOST_CHECK_LT(page.body(ContentCoding::Brotli)->size(), page.body(ContentCoding::Gzip)->size());
+#else
+    BOOST_CHECK(!page.body(ContentCoding::Brotli));
+#endif
+
+    // Not worth it
+    StaticResponse image(HttpCode::Ok, PAGE, {{"Content-Type", "image/png"}});
+    BOOST_CHECK(!image.body(ContentCoding::Gzip));
+    StaticResponse small(HttpCode::Ok, "ok");
+    BOOST_CHECK(!small.body(ContentCoding::Gzip));
+}
+
+BOOST_AUTO_TEST_CASE(apply)
+{
+    StaticResponse page(HttpCode::Ok, PAGE, {{"Content-Type", "text/html"}});
+
+    auto send = [&page](const char* accept)
+    {
+        Request request;
+        if (accept)
+        {
+            request.addHeader("Accept-Encoding");
+            request.setHeaderValue(accept);
+        }
+        Response response;
+        response.setCompression(true);
+        page.apply(request, response);
+        return split(serialize(response));
+    };
+
+    auto gzip = send("gzip");
+    BOOST_CHECK(gzip.has("Content-Encoding: gzip"));
+    BOOST_CHECK(gzip.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(gzip.has("Content-Type: text/html"));
+    BOOST_CHECK(inflate(gzip.body) == PAGE);
+
+    auto identity = send(nullptr);
+    BOOST_CHECK(identity.head.find("Content-Encoding") == std::string::npos);
+    BOOST_CHECK(identity.has("Vary: Accept-Encoding"));
+    BOOST_CHECK(identity.body == PAGE);
+
+    auto br = send("br");
+#if HTTPP_WITH_BROTLI
+    BOOST_CHECK(br.has("Content-Encoding: br"));
+#else
+    BOOST_CHECK(br.head.find("Content-Encoding") == std::string::npos);
+#endif
+
+    auto preferred = send("br, gzip;q=0.5");
+#if HTTPP_WITH_BROTLI
+    BOOST_CHECK(preferred.has("Content-Encoding: br"));
+#else
+    BOOST_CHECK(preferred.has("Content-Encoding: gzip"));
+#endif
+
+    // The variants are shared with the responses, never copied.
+    const auto& body = page.body(ContentCoding::Deflate);
+    auto count = body.use_count();
+    {
+        Request request;
+        request.addHeader("Accept-Encoding");
+        request.setHeaderValue("deflate");
+        Response response;
+        page.apply(request, response);
+        BOOST_CHECK_EQUAL(body.use_count(), count + 1);
+    }
+    BOOST_CHECK_EQUAL(body.use_count(), count);
+}
+
+BOOST_AUTO_TEST_CASE(given_etag)
+{
+    auto send = [](const StaticResponse& page, const char* accept, Response& response)
+    {
+        Request request;
+        request.addHeader("Accept-Encoding");
+        request.setHeaderValue(accept);
+        page.apply(request, response);
+    };
+
+    StaticResponse page(HttpCode::Ok, PAGE, {{"Content-Type", "text/html"}, {"ETag", "W/\"v1\""}});
+    Response identity;
+    send(page, "identity", identity);
+    BOOST_CHECK(identity.isNotModified("\"v1\"", ""));
+    BOOST_CHECK(!identity.isNotModified("\"v2\"", ""));
+    auto sent = split(serialize(identity));
+    BOOST_CHECK(sent.has("ETag: W/\"v1\""));
+    BOOST_CHECK_EQUAL(sent.head.find("ETag"), sent.head.rfind("ETag"));
+
+    Response gzip;
+    send(page, "gzip", gzip);
+    BOOST_CHECK(gzip.isNotModified("W/\"v1-gzip\"", ""));
+    BOOST_CHECK(split(serialize(gzip)).has("ETag: W/\"v1-gzip\""));
+
+    // A malformed one is replaced with the hash of the body
+    StaticResponse malformed(HttpCode::Ok, PAGE, {{"ETag", "v1"}});
+    Response response;
+    send(malformed, "identity", response);
+    auto hashed = split(serialize(response));
+    BOOST_CHECK(!hashed.has("ETag: v1"));
+    BOOST_CHECK(hashed.head.find("ETag: \"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(dispatcher_route)
+{
+    HttpServer server;
+    server.start();
+
+    HTTP::RestDispatcher dispatcher(server);
+    dispatcher.add<HTTP::Method::GET>(
+        "/page",
+        std::make_shared<const StaticResponse>(
+            HttpCode::Ok, PAGE, std::vector<HTTP::Header>{{"Content-Type", "text/html"}}
+        )
+    );
+    server.bind("localhost");
+
+    boost::asio::io_service io_service;
+    auto s = connect(io_service);
+    boost::asio::streambuf buffer;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        boost::asio::write(
+            s, boost::asio::buffer("GET /page HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n"s)
+        );
+        auto sent = read_response(s, buffer);
+        BOOST_CHECK(sent.has("Content-Encoding: gzip"));
+        BOOST_CHECK(inflate(sent.body) == PAGE);
+    }
+
+    server.stop();
+}
@@ -0,0 +1,158 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/utils/LazyDecodedValue.hpp"
+#include "httpp/utils/URL.hpp"
+
+using namespace HTTPP::UTILS;
+
+static std::string decode(const std::string& str)
+{
+    std::string out;
+    url_decode(str.data(), str.data() + str.size(), out);
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(find_escape)
+{
+    // Around the sizes of the SIMD blocks and words, the fillers are one
+    // bit away from the escapes.
+    for (char filler : {'a', '&', '*', '/', '\xa5', '\xab'})
+    {
+        for (size_t size = 0; size < 100; ++size)
+        {
+            std::string str(size, filler);
+            auto begin = str.data(), end = begin + size;
+            BOOST_CHECK(find_url_escape(begin, end) == end);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                str[i] = i % 2 ? '%' : '+';
+                BOOST_CHECK(find_url_escape(begin, end) == begin + i);
+                BOOST_CHECK(find_url_escape(begin + i + 1, end) == end);
+                str[i] = filler;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(same_as_reference)
+{
+    const std::string escapes[] = {"%20", "+", "%2c", "%E2%80%98", "%0d%0a", "%41"};
+    for (size_t size = 0; size < 80; ++size)
+    {
+        for (const auto& escape : escapes)
+        {
+            std::string str(size, 'x');
+            str.insert(size / 3, escape);
+            str += escape;
+            BOOST_CHECK_EQUAL(decode(str), url_decode(str));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_escapes)
+{
+    BOOST_CHECK_EQUAL(decode("%"), "%");
+    BOOST_CHECK_EQUAL(decode("a%2"), "a%2");
+    BOOST_CHECK_EQUAL(decode("%zz%41"), "%zzA");
+    BOOST_CHECK_EQUAL(decode("100%+"), "100% ");
+}
+
+BOOST_AUTO_TEST_CASE(lazy_value)
+{
+    const std::string raw = "no_escape_here";
+    LazyDecodedValue value(raw);
+    BOOST_CHECK(value.view().data() == raw.data());
+    BOOST_CHECK_EQUAL(value.string(), raw);
+    BOOST_CHECK_EQUAL(value.view(), raw);
+
+    LazyDecodedValue escaped("a%20b+c");
+    BOOST_CHECK_EQUAL(escaped.view(), "a b c");
+    BOOST_CHECK_EQUAL(escaped.string(), "a b c");
+    BOOST_CHECK_EQUAL(escaped.raw(), "a%20b+c");
+
+    LazyDecodedValue empty("");
+    BOOST_CHECK(empty.view().empty());
+    BOOST_CHECK(empty.string().empty());
+    BOOST_CHECK(empty == "");
+
+    // Equality agrees with the ordering, both on the decoded values
+    LazyDecodedValue plus("a+b"), space("a%20b"), other("a%20c");
+    BOOST_CHECK(plus == space);
+    BOOST_CHECK(!(plus < space) && !(space < plus));
+    BOOST_CHECK(!(space == other));
+    BOOST_CHECK(space < other);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_query_values)
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t iterations = 200000;
+
+    // What an API call typically carries, mostly without anything to decode
+    const std::vector<std::string> values = {
+        "1",
+        "20",
+        "relevance",
+        "2026-10-17T12:00:00Z",
+        "en_US",
+        "d41d8cd98f00b204e9800998ecf8427e",
+        "red+running+shoes",
+        "caf%C3%A9%20au%20lait",
+        "https%3A%2F%2Fexample.com%2Fcallback%3Fstate%3Dabc",
+        "a_somewhat_longer_value_that_spans_more_than_one_simd_block",
+    };
+
+    size_t bytes = 0;
+    for (const auto& value : values)
+    {
+        bytes += value.size();
+    }
+    bytes *= iterations;
+
+    size_t checksum = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (const auto& value : values)
+        {
+            checksum += url_decode(value).size();
+        }
+    }
+    auto eager = Clock::now() - start;
+
+    size_t lazy_checksum = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (const auto& value : values)
+        {
+            lazy_checksum += LazyDecodedValue(value).view().size();
+        }
+    }
+    auto lazy = Clock::now() - start;
+
+    BOOST_CHECK_EQUAL(checksum, lazy_checksum);
+
+    auto rate = [&](Clock::duration d)
+    {
+        return bytes / std::chrono::duration<double>(d).count() / (1024 * 1024);
+    };
+
+    BOOST_TEST_MESSAGE("url_decode into a new string: " << rate(eager) << " MiB/s");
+    BOOST_TEST_MESSAGE("LazyDecodedValue::view: " << rate(lazy) << " MiB/s");
+}
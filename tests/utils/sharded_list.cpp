@@ -0,0 +1,127 @@
+/*
+ * Part of HTTPP.
+ *
+ * Distributed under the 2-clause BSD licence (See LICENCE.TXT file at the
+ * project root).
+ *
+ * Copyright (c) 2026 the HTTPP contributors.
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "httpp/utils/ShardedIntrusiveList.hpp"
+
+using namespace HTTPP::UTILS;
+
+struct Item
+{
+    ShardedListHook hook;
+    size_t shard = 0;
+};
+
+using List = ShardedIntrusiveList<Item, &Item::hook>;
+
+BOOST_AUTO_TEST_CASE(insert_erase)
+{
+    List list(4);
+    std::vector<Item> items(10);
+
+    for (auto& item : items)
+    {
+        item.shard = list.insert(item);
+    }
+
+    size_t count = 0;
+    list.for_each(
+        [&count](Item&)
+        {
+            ++count;
+        }
+    );
+    BOOST_CHECK_EQUAL(count, items.size());
+
+    BOOST_CHECK(list.erase(items[3], items[3].shard));
+    BOOST_CHECK(!list.erase(items[3], items[3].shard));
+
+    count = 0;
+    list.for_each(
+        [&count](Item&)
+        {
+            ++count;
+        }
+    );
+    BOOST_CHECK_EQUAL(count, items.size() - 1);
+
+    for (auto& item : items)
+    {
+        list.erase(item, item.shard);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(erase_from_another_thread)
+{
+    List list(8);
+    std::vector<Item> items(8 * 1000);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t)
+    {
+        threads.emplace_back(
+            [&list, &items, t]
+            {
+                for (size_t i = t * 1000; i < (t + 1) * 1000; ++i)
+                {
+                    items[i].shard = list.insert(items[i]);
+                }
+            }
+        );
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+
+    // Remove with a different thread than the one which inserted.
+    std::atomic_int erased = {0};
+    for (size_t t = 0; t < 8; ++t)
+    {
+        threads.emplace_back(
+            [&list, &items, &erased, t]
+            {
+                auto other = (t + 1) % 8;
+                for (size_t i = other * 1000; i < (other + 1) * 1000; i += 2)
+                {
+                    erased += list.erase(items[i], items[i].shard);
+                }
+            }
+        );
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    BOOST_CHECK_EQUAL(erased, items.size() / 2);
+
+    size_t count = 0;
+    list.for_each(
+        [&count](Item&)
+        {
+            ++count;
+        }
+    );
+    BOOST_CHECK_EQUAL(count, items.size() / 2);
+
+    for (auto& item : items)
+    {
+        list.erase(item, item.shard);
+    }
+}